@@ -0,0 +1,176 @@
+#include <any>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "../src/interpreter/Interpreter.hpp"
+
+
+std::filesystem::path const program_location = std::filesystem::current_path();
+std::vector<std::string> include_path;
+
+namespace {
+
+    using Interpreter::Data;
+    using Interpreter::Object;
+    using Interpreter::ObjectPtr;
+
+    /**
+     * The former std::any based representation of Interpreter::Data, kept as a baseline.
+    */
+    class AnyData : protected std::any {
+
+    public:
+
+        using Comparators = std::map<std::pair<std::type_index, std::type_index>, std::function<bool(std::any const&, std::any const&)>>;
+
+        template<typename T>
+        static inline std::pair<std::pair<std::type_index, std::type_index>, std::function<bool(std::any const&, std::any const&)>> SimpleComparator = {
+            {std::type_index(typeid(T)), std::type_index(typeid(T))},
+            [](std::any const& a, std::any const& b) {
+                return std::any_cast<T>(a) == std::any_cast<T>(b);
+            }
+        };
+
+        static inline Comparators comparators = {
+            SimpleComparator<ObjectPtr>,
+            SimpleComparator<char>,
+            SimpleComparator<OV_FLOAT>,
+            SimpleComparator<OV_INT>,
+            SimpleComparator<bool>,
+        };
+
+        AnyData() = default;
+        explicit AnyData(ObjectPtr object) : std::any(std::move(object)) {}
+        explicit AnyData(OV_INT i) : std::any(i) {}
+
+        friend bool operator==(AnyData const& a, AnyData const& b) {
+            if (!a.has_value() && !b.has_value())
+                return true;
+
+            auto it = comparators.find({ std::type_index(a.type()), std::type_index(b.type()) });
+            if (it != comparators.end())
+                return it->second(a, b);
+            else
+                return false;
+        }
+
+        template<typename T>
+        [[nodiscard]] T const& get() const {
+            try {
+                return std::any_cast<T const&>(*this);
+            } catch (std::bad_any_cast const&) {
+                throw Data::BadAccess();
+            }
+        }
+        template<typename T>
+        [[nodiscard]] bool is() const {
+            return std::any_cast<T const>(this);
+        }
+
+    };
+
+    /**
+     * Runs an operation on a vector of data and returns its mean cost.
+     * @param values the data to work on.
+     * @param rounds the number of passes over the data.
+     * @param operation the operation, called with two data.
+     * @return the cost of one operation in nanoseconds.
+    */
+    template<typename D, typename F>
+    double measure(std::vector<D> const& values, size_t rounds, F const& operation) {
+        volatile size_t sink = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r)
+            for (size_t i = 1; i < values.size(); ++i)
+                sink = sink + operation(values[i - 1], values[i]);
+        auto const end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * (values.size() - 1));
+    }
+
+    template<typename D>
+    std::vector<D> make_integers(size_t size) {
+        std::vector<D> values;
+        for (size_t i = 0; i < size; ++i)
+            values.emplace_back(static_cast<OV_INT>(i % 7));
+        return values;
+    }
+
+    template<typename D>
+    std::vector<D> make_objects(size_t size) {
+        std::vector<D> values;
+        auto const a = std::make_shared<Object>();
+        auto const b = std::make_shared<Object>();
+        for (size_t i = 0; i < size; ++i)
+            values.emplace_back(i % 3 ? a : b);
+        return values;
+    }
+
+    void report(std::string const& operation, double before, double after) {
+        std::cout << std::left << std::setw(16) << operation
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(12) << before << std::setw(12) << after << std::endl;
+    }
+
+    struct Costs {
+        double copy;
+        double is;
+        double get;
+        double equals_int;
+        double equals_object;
+    };
+
+    template<typename D>
+    Costs run(size_t size, size_t rounds) {
+        auto const integers = make_integers<D>(size);
+        auto const objects = make_objects<D>(size);
+
+        return Costs{
+            .copy = measure(objects, rounds, [](D const& a, D const&) {
+                D copy = a;
+                return copy.template is<ObjectPtr>() ? size_t(1) : size_t(0);
+            }),
+            .is = measure(integers, rounds, [](D const& a, D const&) {
+                return a.template is<OV_INT>() ? size_t(1) : size_t(0);
+            }),
+            .get = measure(integers, rounds, [](D const& a, D const&) {
+                return static_cast<size_t>(a.template get<OV_INT>());
+            }),
+            .equals_int = measure(integers, rounds, [](D const& a, D const& b) {
+                return a == b ? size_t(1) : size_t(0);
+            }),
+            .equals_object = measure(objects, rounds, [](D const& a, D const& b) {
+                return a == b ? size_t(1) : size_t(0);
+            })
+        };
+    }
+
+}
+
+int main(int argc, char** argv) {
+    size_t const rounds = argc > 1 ? std::stoul(argv[1]) : 1000;
+    size_t const size = 10000;
+
+    auto const before = run<AnyData>(size, rounds);
+    auto const after = run<Data>(size, rounds);
+
+    std::cout << std::left << std::setw(16) << "ns/operation" << std::right << std::setw(12) << "std::any" << std::setw(12) << "tagged" << std::endl;
+    report("copy object", before.copy, after.copy);
+    report("is<int>", before.is, after.is);
+    report("get<int>", before.get, after.get);
+    report("== int", before.equals_int, after.equals_int);
+    report("== object", before.equals_object, after.equals_object);
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "../src/interpreter/Interpreter.hpp"
+
+#include "../src/parser/Expressions.hpp"
+
+
+std::filesystem::path const program_location = std::filesystem::current_path();
+std::vector<std::string> include_path;
+
+namespace {
+
+    using namespace Interpreter;
+
+    auto const parameters = std::make_shared<Parser::Symbol>("a");
+
+    /**
+     * The ways an overload can reject the arguments.
+    */
+    enum class Rejection {
+        /**
+         * A native overload returning nothing.
+        */
+        Status,
+        /**
+         * A custom overload whose parameters do not match.
+        */
+        Pattern
+    };
+
+    /**
+     * Makes a function whose first overloads reject an integer argument and whose last overload accepts it.
+     * @param rejection the way the first overloads reject the argument.
+     * @param n the number of rejecting overloads.
+     * @return the function.
+    */
+    ObjectPtr make_function(Rejection rejection, size_t n) {
+        auto function = GC::new_object();
+
+        auto const pair = std::make_shared<Parser::Tuple>(Parser::Tuple({
+            std::make_shared<Parser::Symbol>("x"),
+            std::make_shared<Parser::Symbol>("y")
+        }));
+        auto const definition = std::make_shared<Parser::FunctionDefinition>(pair, nullptr, std::make_shared<Parser::Symbol>("x"));
+
+        for (size_t i = 0; i < n; ++i) {
+            switch (rejection) {
+            case Rejection::Status:
+                function->functions.emplace_back(SystemFunction{ parameters, [](FunctionContext&) -> std::optional<Reference> {
+                    return std::nullopt;
+                } });
+                break;
+            case Rejection::Pattern:
+                function->functions.emplace_back(CustomFunction{ definition });
+                break;
+            }
+        }
+
+        function->functions.emplace_back(SystemFunction{ parameters, [](FunctionContext& context) -> Reference {
+            return context["a"];
+        } });
+
+        return function;
+    }
+
+    /**
+     * Measures the cost of calling a function.
+     * @param context the context of the calls.
+     * @param function the function.
+     * @param calls the number of calls.
+     * @return the cost of one call in nanoseconds.
+    */
+    double measure(GlobalContext& context, ObjectPtr const& function, size_t calls) {
+        Reference const argument = Data(static_cast<OV_INT>(1));
+        auto const start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < calls; ++i)
+            (void) call_function(context, nullptr, Data(function), argument);
+        auto const end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(calls);
+    }
+
+}
+
+int main(int argc, char** argv) {
+    size_t const calls = argc > 1 ? std::stoul(argv[1]) : 20000;
+
+    GlobalContext context(nullptr);
+
+    std::cout << std::left << std::setw(12) << "rejections"
+        << std::right << std::setw(14) << "status" << std::setw(14) << "pattern"
+        << "  (ns/call)" << std::endl;
+    for (size_t n : { 0, 1, 2, 4, 8, 16, 32 }) {
+        std::cout << std::left << std::setw(12) << n << std::right << std::fixed << std::setprecision(1);
+        for (auto rejection : { Rejection::Status, Rejection::Pattern })
+            std::cout << std::setw(14) << measure(context, make_function(rejection, n), calls);
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
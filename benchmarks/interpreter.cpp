@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../src/interpreter/Counters.hpp"
+#include "../src/interpreter/Interpreter.hpp"
+
+#include "../src/parser/Expressions.hpp"
+#include "../src/parser/Standard.hpp"
+
+
+std::filesystem::path const program_location = std::filesystem::current_path();
+std::vector<std::string> include_path;
+
+namespace {
+
+    using namespace Interpreter;
+
+    struct Result {
+        std::string name;
+        size_t ops = 0;
+        double seconds = 0;
+        double allocations = 0;
+
+        [[nodiscard]] double get_ops_per_second() const {
+            return static_cast<double>(ops) / seconds;
+        }
+    };
+
+    /**
+     * Counts the objects and the references allocated so far.
+     * @return the number of allocations.
+    */
+    uint64_t get_allocations() {
+        auto const counters = Counters::get();
+        return counters[static_cast<size_t>(Counters::Counter::Objects)] + counters[static_cast<size_t>(Counters::Counter::References)];
+    }
+
+    /**
+     * Executes a script in a new global context, as the interpreter does for the file it is given.
+     * @param path the path of the script.
+     * @param code the content of the script.
+     * @return the global context.
+    */
+    std::unique_ptr<GlobalContext> run_script(std::filesystem::path const& path, std::string const& code) {
+        auto expression = Parser::Standard(code, path.string()).get_tree();
+
+        auto context = std::make_unique<GlobalContext>(expression);
+        std::set<std::string> symbols = context->get_symbols();
+        context->sources[std::filesystem::canonical(path)] = expression;
+        expression->compute_symbols(symbols);
+
+        (void) execute(*context, expression);
+        return context;
+    }
+
+    /**
+     * Measures a script for a given duration.
+     * An operation is a call to the function bench of the script, or the execution of the whole script in a new context if it defines no such function.
+     * @param path the path of the script.
+     * @param duration the minimal duration of the measure in seconds, one operation is always run before it.
+     * @return the result.
+    */
+    Result measure(std::filesystem::path const& path, double duration) {
+        std::ifstream file(path);
+        std::ostringstream oss;
+        oss << file.rdbuf();
+        auto const code = oss.str();
+
+        auto const context = run_script(path, code);
+        std::function<void()> op;
+        if (context->has_symbol("bench")) {
+            auto const bench = (*context)["bench"];
+            auto const arguments = std::make_shared<Parser::Tuple>();
+            op = [&context, bench, arguments]() {
+                (void) call_function(*context, nullptr, bench, arguments);
+            };
+        } else {
+            op = [&path, &code]() {
+                (void) run_script(path, code);
+            };
+        }
+
+        op();
+
+        Result result;
+        result.name = path.stem().string();
+        auto const allocations = get_allocations();
+        auto const start = std::chrono::steady_clock::now();
+        do {
+            op();
+            ++result.ops;
+            result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (result.seconds < duration);
+        result.allocations = static_cast<double>(get_allocations() - allocations) / static_cast<double>(result.ops);
+
+        return result;
+    }
+
+    void write_json(std::ostream& os, std::vector<Result> const& results) {
+        os << "{\n    \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            auto const& result = results[i];
+            os << (i == 0 ? "\n" : ",\n")
+                << "        {"
+                << " \"name\": \"" << result.name << "\","
+                << " \"ops\": " << result.ops << ","
+                << " \"seconds\": " << result.seconds << ","
+                << " \"ops_per_second\": " << result.get_ops_per_second() << ","
+                << " \"allocations_per_op\": " << result.allocations
+                << " }";
+        }
+        os << "\n    ]\n}\n";
+    }
+
+    /**
+     * Reads the operations per second of a JSON file written by write_json.
+     * @param path the path of the file.
+     * @return the operations per second by benchmark name.
+    */
+    std::map<std::string, double> read_baseline(std::filesystem::path const& path) {
+        std::ifstream file(path);
+        std::ostringstream oss;
+        oss << file.rdbuf();
+        auto const json = oss.str();
+
+        std::map<std::string, double> baseline;
+        std::regex const entry(R"re("name":\s*"([^"]*)"[^}]*"ops_per_second":\s*([-+0-9.eE]+))re");
+        for (std::sregex_iterator it(json.begin(), json.end(), entry), end; it != end; ++it)
+            baseline[(*it)[1].str()] = std::stod((*it)[2].str());
+        return baseline;
+    }
+
+}
+
+/**
+ * Usage: ouverium_bench [--time seconds] [--json file] [--baseline file] [--tolerance ratio] [scripts...]
+ * The scripts default to the ones of benchmarks/scripts, and the libraries are imported from libraries, both from the current directory.
+ * With a baseline, the benchmarks slower than the baseline by more than the tolerance are reported and the exit code is a failure.
+*/
+int main(int argc, char** argv) {
+    double duration = 1.;
+    double tolerance = .1;
+    std::string json;
+    std::string baseline_path;
+    std::vector<std::filesystem::path> scripts;
+    for (int i = 1; i < argc; ++i) {
+        std::string const argument = argv[i];
+        if (argument == "--time" && i + 1 < argc)
+            duration = std::stod(argv[++i]);
+        else if (argument == "--json" && i + 1 < argc)
+            json = argv[++i];
+        else if (argument == "--baseline" && i + 1 < argc)
+            baseline_path = argv[++i];
+        else if (argument == "--tolerance" && i + 1 < argc)
+            tolerance = std::stod(argv[++i]);
+        else
+            scripts.emplace_back(argument);
+    }
+
+    include_path.push_back((program_location / "libraries").string());
+    if (scripts.empty()) {
+        for (auto const& entry : std::filesystem::directory_iterator("benchmarks/scripts"))
+            if (entry.is_regular_file() && entry.path().extension() == ".fl")
+                scripts.push_back(entry.path());
+        std::sort(scripts.begin(), scripts.end());
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baseline_path.empty())
+        baseline = read_baseline(baseline_path);
+
+    std::vector<Result> results;
+    bool regression = false;
+    std::cout << std::left << std::setw(16) << "benchmark"
+        << std::right << std::setw(14) << "ops/s" << std::setw(16) << "allocations/op" << std::setw(12) << "baseline" << std::endl;
+    for (auto const& script : scripts) {
+        try {
+            auto const& result = results.emplace_back(measure(script, duration));
+            std::cout << std::left << std::setw(16) << result.name << std::right << std::fixed
+                << std::setw(14) << std::setprecision(2) << result.get_ops_per_second()
+                << std::setw(16) << std::setprecision(0) << result.allocations;
+
+            if (auto it = baseline.find(result.name); it != baseline.end()) {
+                auto const change = result.get_ops_per_second() / it->second - 1.;
+                std::cout << std::setw(11) << std::showpos << std::setprecision(1) << change * 100. << '%' << std::noshowpos;
+                if (change < -tolerance) {
+                    std::cout << "  regression";
+                    regression = true;
+                }
+            }
+            std::cout << std::endl;
+        } catch (Exception const&) {
+            std::cerr << "the benchmark \"" << script.string() << "\" threw an exception." << std::endl;
+            return EXIT_FAILURE;
+        } catch (Parser::Standard::IncompleteCode const&) {
+            std::cerr << "incomplete code, you must finish the last expression in file \"" << script.string() << "\"." << std::endl;
+            return EXIT_FAILURE;
+        } catch (Parser::Standard::Exception const& e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (!json.empty()) {
+        std::ofstream file(json);
+        write_json(file, results);
+        if (!file) {
+            std::cerr << "unable to write the file \"" << json << "\"." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    return regression ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/parser/Standard.hpp"
+
+
+namespace {
+
+    /**
+     * Reads the source files of a directory and of its subdirectories.
+     * @param directory the directory.
+     * @return the paths and the contents of the files.
+    */
+    std::vector<std::pair<std::string, std::string>> read_sources(std::filesystem::path const& directory) {
+        std::vector<std::pair<std::string, std::string>> sources;
+        for (auto const& entry : std::filesystem::recursive_directory_iterator(directory)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".fl") {
+                std::ifstream file(entry.path());
+                std::ostringstream oss;
+                oss << file.rdbuf();
+                sources.emplace_back(entry.path().string(), oss.str());
+            }
+        }
+        return sources;
+    }
+
+    /**
+     * Measures the throughput of a step of the parser on some sources.
+     * @param sources the sources.
+     * @param rounds the number of times each source is processed.
+     * @param step the step, which returns a value depending on its result so that it is not optimized out.
+     * @return the throughput in MB/s.
+    */
+    template<typename Step>
+    double measure(std::vector<std::pair<std::string, std::string>> const& sources, size_t rounds, Step step) {
+        size_t bytes = 0;
+        size_t check = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (size_t r = 0; r < rounds; ++r) {
+            for (auto const& [path, code] : sources) {
+                check += step(Parser::Standard(code, path));
+                bytes += code.size();
+            }
+        }
+        std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+
+        if (check == 0)
+            std::cerr << "nothing was parsed" << std::endl;
+        return static_cast<double>(bytes) / 1e6 / duration.count();
+    }
+
+}
+
+int main(int argc, char** argv) {
+    std::filesystem::path const directory = argc > 1 ? argv[1] : "libraries";
+    size_t const rounds = argc > 2 ? std::stoul(argv[2]) : 20;
+
+    auto const sources = read_sources(directory);
+    size_t size = 0;
+    for (auto const& source : sources)
+        size += source.second.size();
+    std::cout << sources.size() << " files, " << size << " bytes" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(12) << "words" << std::right << std::setw(10) << measure(sources, rounds, [](Parser::Standard const& parser) {
+        return parser.get_words().size();
+    }) << " MB/s" << std::endl;
+    std::cout << std::left << std::setw(12) << "tree" << std::right << std::setw(10) << measure(sources, rounds, [](Parser::Standard const& parser) {
+        return parser.get_tree() != nullptr ? 1 : 0;
+    }) << " MB/s" << std::endl;
+
+    return 0;
+}
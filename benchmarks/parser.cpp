@@ -0,0 +1,62 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "../src/parser/Standard.hpp"
+
+
+namespace {
+
+    /**
+     * Generates a synthetic source, made of functions whose bodies contain statements with operators and brackets.
+     * @param size the minimal size of the source in bytes.
+     * @return the source.
+    */
+    std::string generate_source(size_t size) {
+        std::string code;
+        code.reserve(size + 4096);
+        while (code.size() < size) {
+            code += "function := x -> {\n";
+            for (size_t j = 0; j < 50; ++j) {
+                auto const n = std::to_string(j);
+                code += "    value := (a + b * c - (d / e) ^ f) % g;\n";
+                code += "    f(x, [y, z], { w <- \"" + n + "\" }) + " + n + ".5;\n";
+            }
+            code += "};\n";
+        }
+        return code;
+    }
+
+    /**
+     * Measures the time taken to build the tree of a source.
+     * @param code the source.
+     * @return the duration in seconds.
+    */
+    double measure(std::string const& code) {
+        auto const start = std::chrono::steady_clock::now();
+        auto const tree = Parser::Standard(code, "synthetic.fl").get_tree();
+        std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+
+        if (tree == nullptr)
+            std::cerr << "nothing was parsed" << std::endl;
+        return duration.count();
+    }
+
+}
+
+int main(int argc, char** argv) {
+    size_t const max_size = argc > 1 ? std::stoul(argv[1]) : 10'000'000;
+
+    std::cout << std::left << std::setw(12) << "bytes" << std::right << std::setw(12) << "seconds" << std::setw(12) << "MB/s" << std::endl;
+    for (size_t size = 1'000; size <= max_size; size *= 10) {
+        auto const code = generate_source(size);
+        auto const duration = measure(code);
+        std::cout << std::left << std::setw(12) << code.size() << std::right << std::fixed
+            << std::setw(12) << std::setprecision(4) << duration
+            << std::setw(12) << std::setprecision(1) << static_cast<double>(code.size()) / 1e6 / duration << std::endl;
+    }
+
+    return 0;
+}
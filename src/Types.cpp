@@ -41,12 +41,14 @@ std::variant<std::nullptr_t, bool, OV_INT, OV_FLOAT, std::string> get_symbol(std
     if (name == "true") return true;
     if (name == "false") return false;
 
+    auto const* end = name.data() + name.size();
+
     OV_INT i{};
-    if (std::from_chars(name.data(), name.data() + name.size(), i).ec == std::errc())
+    if (auto [ptr, ec] = std::from_chars(name.data(), end, i); ec == std::errc() && ptr == end)
         return i;
 
     OV_FLOAT f{};
-    if (std::from_chars(name.data(), name.data() + name.size(), f).ec == std::errc())
+    if (auto [ptr, ec] = std::from_chars(name.data(), end, f); ec == std::errc() && ptr == end)
         return f;
 
     return nullptr;
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <variant>
+
+#include "Bytecode.hpp"
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Compiler {
+
+    namespace {
+
+        class Emitter {
+
+            Bytecode& bytecode;
+            std::shared_ptr<Parser::Expression> const& root;
+            size_t stack = 0;
+
+            void emit(OpCode code, size_t operand, int effect) {
+                bytecode.instructions.push_back(Instruction{ .code = code, .operand = static_cast<uint32_t>(operand) });
+                stack = static_cast<size_t>(static_cast<std::ptrdiff_t>(stack) + effect);
+                bytecode.stack_size = std::max(bytecode.stack_size, stack);
+            }
+
+            size_t add_expression(std::shared_ptr<Parser::Expression> const& expression) {
+                if (expression == root)
+                    return 0;
+                bytecode.expressions.push_back(expression);
+                return bytecode.expressions.size() - 1;
+            }
+
+            template<typename T>
+            size_t add_literal(T&& literal) {
+                bytecode.literals.emplace_back(std::forward<T>(literal));
+                return bytecode.literals.size() - 1;
+            }
+
+        public:
+
+            Emitter(Bytecode& bytecode, std::shared_ptr<Parser::Expression> const& root) :
+                bytecode(bytecode), root(root) {
+                bytecode.expressions.emplace_back();
+            }
+
+            void compile(std::shared_ptr<Parser::Expression> const& expression) {
+                if (auto function_call = std::dynamic_pointer_cast<Parser::FunctionCall>(expression)) {
+                    compile(function_call->function);
+                    emit(OpCode::Call, add_expression(expression), 0);
+                } else if (auto function_definition = std::dynamic_pointer_cast<Parser::FunctionDefinition>(expression)) {
+                    emit(OpCode::Function, add_expression(expression), 1);
+                } else if (auto property = std::dynamic_pointer_cast<Parser::Property>(expression)) {
+                    compile(property->object);
+                    emit(OpCode::Property, add_expression(expression), 0);
+                } else if (auto literal = std::dynamic_pointer_cast<Parser::Literal>(expression)) {
+                    if (std::holds_alternative<std::string>(literal->value))
+                        emit(OpCode::String, add_literal(literal->value), 1);
+                    else
+                        emit(OpCode::Constant, add_literal(literal->value), 1);
+                } else if (std::dynamic_pointer_cast<Parser::Symbol>(expression)) {
+                    emit(OpCode::Symbol, add_expression(expression), 1);
+                } else if (auto tuple = std::dynamic_pointer_cast<Parser::Tuple>(expression)) {
+                    for (auto const& e : tuple->objects)
+                        compile(e);
+                    emit(OpCode::Tuple, tuple->objects.size(), 1 - static_cast<int>(tuple->objects.size()));
+                }
+            }
+
+        };
+
+    }
+
+    std::shared_ptr<Bytecode const> compile(std::shared_ptr<Parser::Expression> const& expression) {
+        auto bytecode = std::make_shared<Bytecode>();
+        Emitter(*bytecode, expression).compile(expression);
+        return bytecode;
+    }
+
+    Bytecode const& get_bytecode(std::shared_ptr<Parser::Expression> const& expression) {
+        auto bytecode = expression->bytecode.load(std::memory_order_acquire);
+        if (!bytecode) {
+            // Threads compiling the same expression keep the first published bytecode, which is never replaced
+            auto compiled = compile(expression);
+            if (expression->bytecode.compare_exchange_strong(bytecode, compiled, std::memory_order_acq_rel, std::memory_order_acquire))
+                bytecode = std::move(compiled);
+        }
+        return *bytecode;
+    }
+
+}
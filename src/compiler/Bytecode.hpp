@@ -0,0 +1,85 @@
+#ifndef __COMPILER_BYTECODE_HPP__
+#define __COMPILER_BYTECODE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Compiler {
+
+    /**
+     * The operations of the virtual machine, each one works on a stack of references.
+    */
+    enum class OpCode : uint8_t {
+        /**
+         * Pushes a boolean, an integer or a float literal.
+        */
+        Constant,
+        /**
+         * Pushes a new string object built from a string literal.
+        */
+        String,
+        /**
+         * Pushes the reference of a symbol of the context.
+        */
+        Symbol,
+        /**
+         * Pops an object and pushes the reference to one of its properties.
+        */
+        Property,
+        /**
+         * Pops a function and pushes the result of its call, the arguments stay unevaluated expressions.
+        */
+        Call,
+        /**
+         * Pushes a new function object capturing the symbols of the context.
+        */
+        Function,
+        /**
+         * Pops the n last references and pushes them as a tuple.
+        */
+        Tuple
+    };
+
+    struct Instruction {
+        OpCode code;
+        uint32_t operand;
+    };
+
+    using Literal = Parser::Literal::Value;
+
+    /**
+     * The compiled form of an expression.
+     * Its instructions are executed in order and leave the result of the expression alone on the stack.
+     * The expression 0 stands for the compiled expression itself, which is not stored to avoid an ownership cycle.
+    */
+    struct Bytecode {
+        std::vector<Instruction> instructions;
+        std::vector<Literal> literals;
+        std::vector<std::shared_ptr<Parser::Expression>> expressions;
+        size_t stack_size = 0;
+    };
+
+    /**
+     * Compiles an expression to bytecode.
+     * The arguments of the function calls are not compiled inline as they are evaluated lazily by the callee.
+     * @param expression the expression to compile.
+     * @return the bytecode of the expression.
+    */
+    [[nodiscard]] std::shared_ptr<Bytecode const> compile(std::shared_ptr<Parser::Expression> const& expression);
+
+    /**
+     * Gets the bytecode of an expression, compiling it on the first call.
+     * @param expression the expression.
+     * @return the bytecode of the expression.
+    */
+    [[nodiscard]] Bytecode const& get_bytecode(std::shared_ptr<Parser::Expression> const& expression);
+
+}
+
+
+#endif
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "Arena.hpp"
+
+
+namespace Interpreter::GC {
+
+    namespace {
+
+        constexpr size_t round_up(size_t size) {
+            return (size + Arena::alignment - 1) / Arena::alignment * Arena::alignment;
+        }
+
+        template<typename Slab>
+        Slab* get_slab(void const* block) {
+            return reinterpret_cast<Slab*>(reinterpret_cast<std::uintptr_t>(block) & ~(Arena::slab_size - 1));
+        }
+
+    }
+
+    Arena::Arena(std::string name) {
+        statistics.name = std::move(name);
+        for (size_t i = 0; i < classes.size(); ++i)
+            classes[i].statistics.block_size = (i + 1) * alignment;
+    }
+
+    Arena::~Arena() {
+        for (auto const& size_class : classes)
+            for (auto* slab : size_class.slabs)
+                ::operator delete(slab, std::align_val_t(slab_size));
+    }
+
+    void Arena::add_slab(SizeClass& size_class) {
+        auto* slab = new (::operator new(slab_size, std::align_val_t(slab_size))) Slab();
+        size_class.slabs.push_back(slab);
+
+        auto const block_size = size_class.statistics.block_size;
+        auto* begin = reinterpret_cast<std::byte*>(slab) + header_size;
+        auto const count = (slab_size - header_size) / block_size;
+        for (size_t i = count; i > 0; --i) {
+            auto* block = new (begin + (i - 1) * block_size) FreeBlock{ size_class.free };
+            size_class.free = block;
+        }
+
+        size_class.statistics.slabs = size_class.slabs.size();
+        ++statistics.slabs;
+    }
+
+    void* Arena::allocate(size_t size) {
+        size = round_up(std::max(size, sizeof(FreeBlock)));
+        if (size > max_block_size)
+            return ::operator new(size);
+
+        std::lock_guard lock(mutex);
+        auto& size_class = classes[size / alignment - 1];
+        if (size_class.free == nullptr)
+            add_slab(size_class);
+
+        auto* block = size_class.free;
+        size_class.free = block->next;
+        ++get_slab<Slab>(block)->used;
+
+        ++size_class.statistics.live;
+        ++size_class.statistics.allocations;
+        ++statistics.allocations;
+        statistics.peak = std::max(statistics.peak, ++statistics.live);
+
+        return block;
+    }
+
+    void Arena::deallocate(void* block, size_t size) {
+        size = round_up(std::max(size, sizeof(FreeBlock)));
+        if (size > max_block_size) {
+            ::operator delete(block);
+            return;
+        }
+
+        std::lock_guard lock(mutex);
+        auto& size_class = classes[size / alignment - 1];
+        --get_slab<Slab>(block)->used;
+        --size_class.statistics.live;
+        --statistics.live;
+
+        size_class.free = new (block) FreeBlock{ size_class.free };
+    }
+
+    void Arena::release() {
+        std::lock_guard lock(mutex);
+
+        auto const is_empty = [](Slab const* slab) {
+            return slab->used == 0;
+        };
+        for (auto& size_class : classes) {
+            if (std::none_of(size_class.slabs.begin(), size_class.slabs.end(), is_empty))
+                continue;
+
+            FreeBlock* kept = nullptr;
+            for (auto* block = size_class.free; block != nullptr;) {
+                auto* next = block->next;
+                if (!is_empty(get_slab<Slab const>(block))) {
+                    block->next = kept;
+                    kept = block;
+                }
+                block = next;
+            }
+            size_class.free = kept;
+
+            statistics.slabs -= std::erase_if(size_class.slabs, [&is_empty](Slab* slab) {
+                if (is_empty(slab)) {
+                    ::operator delete(slab, std::align_val_t(slab_size));
+                    return true;
+                } else
+                    return false;
+            });
+            size_class.statistics.slabs = size_class.slabs.size();
+        }
+    }
+
+    ArenaStatistics Arena::get_statistics() {
+        std::lock_guard lock(mutex);
+        auto result = statistics;
+        for (auto const& size_class : classes)
+            if (size_class.statistics.allocations > 0)
+                result.size_classes.push_back(size_class.statistics);
+        return result;
+    }
+
+}
@@ -0,0 +1,145 @@
+#ifndef __INTERPRETER_ARENA_HPP__
+#define __INTERPRETER_ARENA_HPP__
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+
+namespace Interpreter::GC {
+
+    struct SizeClassStatistics {
+        size_t block_size = 0;
+        size_t slabs = 0;
+        size_t live = 0;
+        size_t allocations = 0;
+    };
+
+    struct ArenaStatistics {
+        std::string name;
+        size_t slabs = 0;
+        size_t live = 0;
+        size_t peak = 0;
+        size_t allocations = 0;
+        /**
+         * The size classes which have allocated a block, by increasing block size.
+        */
+        std::vector<SizeClassStatistics> size_classes;
+    };
+
+    /**
+     * A slab allocator with a size class by multiple of the alignment, each slab holding blocks of a single class.
+     * The slabs are aligned on their size so that a block finds its slab, the slabs left empty are released in bulk.
+    */
+    class Arena {
+
+    public:
+
+        static constexpr size_t slab_size = 1 << 16;
+        static constexpr size_t header_size = 2 * alignof(std::max_align_t);
+        static constexpr size_t alignment = alignof(std::max_align_t);
+        /**
+         * The size of the largest class, the larger blocks are allocated with operator new.
+        */
+        static constexpr size_t max_block_size = 1 << 10;
+
+    private:
+
+        struct Slab {
+            size_t used = 0;
+        };
+
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct SizeClass {
+            std::vector<Slab*> slabs;
+            FreeBlock* free = nullptr;
+            SizeClassStatistics statistics;
+        };
+
+        std::mutex mutex;
+        std::array<SizeClass, max_block_size / alignment> classes;
+        ArenaStatistics statistics;
+
+        void add_slab(SizeClass& size_class);
+
+    public:
+
+        Arena(std::string name);
+        Arena(Arena const&) = delete;
+        Arena(Arena&&) = delete;
+
+        Arena& operator=(Arena const&) = delete;
+        Arena& operator=(Arena&&) = delete;
+
+        ~Arena();
+
+        /**
+         * Allocates a block.
+         * @param size the size of the block, rounded up to its size class.
+         * @return the block.
+        */
+        [[nodiscard]] void* allocate(size_t size);
+
+        /**
+         * Deallocates a block allocated by this arena.
+         * @param block the block.
+         * @param size the size of the block.
+        */
+        void deallocate(void* block, size_t size);
+
+        /**
+         * Frees the slabs which have no used block.
+        */
+        void release();
+
+        [[nodiscard]] ArenaStatistics get_statistics();
+
+    };
+
+    /**
+     * An allocator allocating from an arena, meant to be used with std::allocate_shared.
+    */
+    template<typename T>
+    class ArenaAllocator {
+
+        Arena* arena;
+
+    public:
+
+        using value_type = T;
+
+        ArenaAllocator(Arena& arena) :
+            arena(&arena) {}
+        template<typename U>
+        ArenaAllocator(ArenaAllocator<U> const& allocator) :
+            arena(allocator.get_arena()) {}
+
+        [[nodiscard]] Arena* get_arena() const {
+            return arena;
+        }
+
+        [[nodiscard]] T* allocate(size_t n) {
+            return static_cast<T*>(arena->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t n) {
+            arena->deallocate(p, n * sizeof(T));
+        }
+
+        template<typename U>
+        [[nodiscard]] friend bool operator==(ArenaAllocator const& a, ArenaAllocator<U> const& b) {
+            return a.get_arena() == b.get_arena();
+        }
+
+    };
+
+}
+
+
+#endif
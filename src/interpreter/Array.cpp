@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "Interpreter.hpp"
+
+
+namespace Interpreter {
+
+    namespace {
+
+        /**
+         * Gets the capacity of a vector after it grew, as the standard library does.
+         * @param size the size before the growth.
+         * @param n the size after the growth.
+         * @return the new capacity.
+        */
+        size_t grow(size_t size, size_t n) {
+            return std::max(size * 2, n);
+        }
+
+        /**
+         * Converts a data to an element of a typed array.
+         * @param data the data.
+         * @return the element, or nothing if the data can not be stored in an array of T.
+        */
+        template<typename T>
+        std::optional<T> unbox(Data const& data) {
+            if (auto const* t = get_if<T>(&data))
+                return *t;
+            if constexpr (std::is_same_v<T, OV_FLOAT>)
+                if (auto const* i = get_if<OV_INT>(&data))
+                    return static_cast<OV_FLOAT>(*i);
+            return std::nullopt;
+        }
+
+        template<typename T>
+        std::vector<Data> box(std::vector<T> const& buffer) {
+            std::vector<Data> vector;
+            vector.reserve(buffer.capacity());
+            for (auto x : buffer)
+                vector.emplace_back(x);
+            return vector;
+        }
+
+        /**
+         * Copies elements between two typed arrays as a block of memory.
+         * @return true if both arrays are typed with T.
+        */
+        template<typename T>
+        bool move_buffer(std::vector<T>* buffer, Array const& from, size_t from_i, size_t to_i, size_t n) {
+            if (buffer)
+                if (auto const* from_buffer = from.get_buffer<T>()) {
+                    std::memmove(buffer->data() + to_i, from_buffer->data() + from_i, n * sizeof(T));
+                    return true;
+                }
+            return false;
+        }
+
+    }
+
+    Array::Array() :
+        elements(Chars{ .bytes = {}, .size = 0, .capacity = 0 }) {}
+
+    Array::Array(std::string_view str) :
+        elements(Chars{ .bytes = std::string(str), .size = str.size(), .capacity = str.size() }) {}
+
+    Array::Array(std::vector<OV_FLOAT> floats) :
+        elements(std::move(floats)) {}
+
+    Array::Array(std::vector<OV_INT> ints) :
+        elements(std::move(ints)) {}
+
+    Array::Array(std::vector<Data> vector) :
+        elements(std::move(vector)) {}
+
+    std::vector<Data>& Array::expand() {
+        if (auto* chars = std::get_if<Chars>(&elements)) {
+            std::vector<Data> vector;
+            vector.reserve(chars->capacity);
+            for (auto c : chars->bytes)
+                vector.emplace_back(c);
+            vector.resize(chars->size);
+            elements = std::move(vector);
+        } else if (auto const* floats = get_buffer<OV_FLOAT>())
+            elements = box(*floats);
+        else if (auto const* ints = get_buffer<OV_INT>())
+            elements = box(*ints);
+        return std::get<std::vector<Data>>(elements);
+    }
+
+    size_t Array::size() const {
+        if (auto const* chars = std::get_if<Chars>(&elements))
+            return chars->size;
+        else if (auto const* floats = get_buffer<OV_FLOAT>())
+            return floats->size();
+        else if (auto const* ints = get_buffer<OV_INT>())
+            return ints->size();
+        else
+            return std::get<std::vector<Data>>(elements).size();
+    }
+
+    size_t Array::capacity() const {
+        if (auto const* chars = std::get_if<Chars>(&elements))
+            return chars->capacity;
+        else if (auto const* floats = get_buffer<OV_FLOAT>())
+            return floats->capacity();
+        else if (auto const* ints = get_buffer<OV_INT>())
+            return ints->capacity();
+        else
+            return std::get<std::vector<Data>>(elements).capacity();
+    }
+
+    void Array::reserve(size_t n) {
+        if (auto* chars = std::get_if<Chars>(&elements)) {
+            chars->bytes.reserve(n);
+            chars->capacity = std::max(chars->capacity, n);
+        } else if (auto* floats = get_buffer<OV_FLOAT>())
+            floats->reserve(n);
+        else if (auto* ints = get_buffer<OV_INT>())
+            ints->reserve(n);
+        else
+            std::get<std::vector<Data>>(elements).reserve(n);
+    }
+
+    void Array::resize(size_t n) {
+        if (auto* chars = std::get_if<Chars>(&elements)) {
+            if (n < chars->bytes.size())
+                chars->bytes.resize(n);
+            if (n > chars->capacity)
+                chars->capacity = grow(chars->size, n);
+            chars->size = n;
+        } else if (auto* floats = get_buffer<OV_FLOAT>())
+            floats->resize(n);
+        else if (auto* ints = get_buffer<OV_INT>())
+            ints->resize(n);
+        else {
+            auto& vector = std::get<std::vector<Data>>(elements);
+            if (n == 0)
+                elements = Chars{ .bytes = {}, .size = 0, .capacity = vector.capacity() };
+            else
+                vector.resize(n);
+        }
+    }
+
+    void Array::push_back(Data const& data) {
+        if (auto* chars = std::get_if<Chars>(&elements)) {
+            if (auto const* c = get_if<char>(&data); c && chars->bytes.size() == chars->size) {
+                if (chars->size == chars->capacity)
+                    chars->capacity = grow(chars->size, 1);
+                chars->bytes.push_back(*c);
+                ++chars->size;
+                return;
+            }
+        } else if (auto* floats = get_buffer<OV_FLOAT>()) {
+            if (auto f = unbox<OV_FLOAT>(data)) {
+                floats->push_back(*f);
+                return;
+            }
+        } else if (auto* ints = get_buffer<OV_INT>()) {
+            if (auto i = unbox<OV_INT>(data)) {
+                ints->push_back(*i);
+                return;
+            }
+        }
+        expand().push_back(data);
+    }
+
+    Data Array::get(size_t i) const {
+        if (auto const* chars = std::get_if<Chars>(&elements)) {
+            if (i < chars->bytes.size())
+                return Data(chars->bytes[i]);
+            else
+                return Data{};
+        } else if (auto const* floats = get_buffer<OV_FLOAT>())
+            return Data((*floats)[i]);
+        else if (auto const* ints = get_buffer<OV_INT>())
+            return Data((*ints)[i]);
+        else
+            return std::get<std::vector<Data>>(elements)[i];
+    }
+
+    void Array::set(size_t i, Data const& data) {
+        if (auto* chars = std::get_if<Chars>(&elements)) {
+            auto& bytes = chars->bytes;
+            if (auto const* c = get_if<char>(&data)) {
+                if (i < bytes.size()) {
+                    bytes[i] = *c;
+                    return;
+                } else if (i == bytes.size()) {
+                    bytes.push_back(*c);
+                    return;
+                }
+            } else if (data == Data{}) {
+                if (i >= bytes.size())
+                    return;
+                else if (i + 1 == bytes.size()) {
+                    bytes.pop_back();
+                    return;
+                }
+            }
+        } else if (auto* floats = get_buffer<OV_FLOAT>()) {
+            if (auto f = unbox<OV_FLOAT>(data)) {
+                (*floats)[i] = *f;
+                return;
+            }
+        } else if (auto* ints = get_buffer<OV_INT>()) {
+            if (auto n = unbox<OV_INT>(data)) {
+                (*ints)[i] = *n;
+                return;
+            }
+        }
+        expand()[i] = data;
+    }
+
+    Data& Array::operator[](size_t i) {
+        return expand()[i];
+    }
+
+    void Array::copy(Array const& from, size_t from_i, size_t to_i, size_t n) {
+        auto* to_chars = std::get_if<Chars>(&elements);
+        auto const* from_chars = std::get_if<Chars>(&from.elements);
+        if (to_chars && from_chars && from_i + n <= from_chars->bytes.size() && to_i <= to_chars->bytes.size()) {
+            if (to_chars->bytes.size() < to_i + n)
+                to_chars->bytes.resize(to_i + n);
+            std::memmove(to_chars->bytes.data() + to_i, from_chars->bytes.data() + from_i, n);
+        } else if (!move_buffer(get_buffer<OV_FLOAT>(), from, from_i, to_i, n) && !move_buffer(get_buffer<OV_INT>(), from, from_i, to_i, n)) {
+            if (from_i < to_i) {
+                for (size_t i = n; i > 0; --i)
+                    set(to_i + i - 1, from.get(from_i + i - 1));
+            } else {
+                for (size_t i = 0; i < n; ++i)
+                    set(to_i + i, from.get(from_i + i));
+            }
+        }
+    }
+
+    std::string const* Array::get_string() const {
+        if (auto const* chars = std::get_if<Chars>(&elements); chars && chars->bytes.size() == chars->size)
+            return &chars->bytes;
+        else
+            return nullptr;
+    }
+
+    std::vector<Data> const* Array::get_vector() const {
+        return std::get_if<std::vector<Data>>(&elements);
+    }
+
+    bool operator==(Array const& a, Array const& b) {
+        if (auto const* a_string = a.get_string())
+            if (auto const* b_string = b.get_string())
+                return *a_string == *b_string;
+        if (auto const* a_floats = a.get_buffer<OV_FLOAT>())
+            if (auto const* b_floats = b.get_buffer<OV_FLOAT>())
+                return *a_floats == *b_floats;
+        if (auto const* a_ints = a.get_buffer<OV_INT>())
+            if (auto const* b_ints = b.get_buffer<OV_INT>())
+                return *a_ints == *b_ints;
+
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a.get(i) != b.get(i))
+                return false;
+        return true;
+    }
+
+}
@@ -0,0 +1,126 @@
+#ifndef __INTERPRETER_ARRAY_HPP__
+#define __INTERPRETER_ARRAY_HPP__
+
+// IWYU pragma: private; include "Interpreter.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "Data.hpp"
+
+
+namespace Interpreter {
+
+    /**
+     * The array of an object.
+     * While it only holds characters, they are stored as contiguous bytes followed by the empty elements left by a resize.
+     * A typed array, made by the system functions, stores unboxed floats or integers and converts the integers it gets to floats.
+     * It switches to a vector of data when it gets another element or when an element is accessed by reference.
+    */
+    class Array {
+
+        /**
+         * The compact representation, the bytes are the first elements and the others are empty.
+        */
+        struct Chars {
+            std::string bytes;
+            size_t size;
+            size_t capacity;
+        };
+
+        std::variant<Chars, std::vector<Data>, std::vector<OV_FLOAT>, std::vector<OV_INT>> elements;
+
+        std::vector<Data>& expand();
+
+    public:
+
+        Array();
+        Array(std::string_view str);
+        Array(std::vector<OV_FLOAT> floats);
+        Array(std::vector<OV_INT> ints);
+        Array(std::vector<Data> vector);
+
+        [[nodiscard]] size_t size() const;
+
+        /**
+         * Gets the capacity of the array, which grows as the one of a vector in both representations.
+         * @return the capacity.
+        */
+        [[nodiscard]] size_t capacity() const;
+
+        [[nodiscard]] bool empty() const {
+            return size() == 0;
+        }
+
+        void reserve(size_t n);
+        void resize(size_t n);
+        void push_back(Data const& data);
+
+        /**
+         * Gets an element by value, which keeps the bytes.
+         * @param i the index of the element, lower than the size.
+         * @return the element.
+        */
+        [[nodiscard]] Data get(size_t i) const;
+
+        /**
+         * Sets an element, which keeps the bytes if it is a character following them.
+         * @param i the index of the element, lower than the size.
+         * @param data the new element.
+        */
+        void set(size_t i, Data const& data);
+
+        /**
+         * Gets an element by reference, the array stops storing bytes.
+         * @param i the index of the element, lower than the size.
+         * @return the element.
+        */
+        Data& operator[](size_t i);
+
+        /**
+         * Copies elements from an array, which may be this one, as a block of bytes when possible.
+         * @param from the source array.
+         * @param from_i the index of the first element in the source.
+         * @param to_i the index of the first element in this array.
+         * @param n the number of elements, the two ranges must be in their array.
+        */
+        void copy(Array const& from, size_t from_i, size_t to_i, size_t n);
+
+        /**
+         * Gets the bytes of the array.
+         * @return the bytes, or null if the array does not only hold characters stored as bytes.
+        */
+        [[nodiscard]] std::string const* get_string() const;
+
+        /**
+         * Gets the elements of the array.
+         * @return the elements, or null if the array stores bytes or unboxed numbers.
+        */
+        [[nodiscard]] std::vector<Data> const* get_vector() const;
+
+        /**
+         * Gets the unboxed elements of a typed array.
+         * @return the elements, or null if the array is not typed with T, a float or an integer.
+        */
+        template<typename T>
+        [[nodiscard]] std::vector<T>* get_buffer() {
+            return std::get_if<std::vector<T>>(&elements);
+        }
+        template<typename T>
+        [[nodiscard]] std::vector<T> const* get_buffer() const {
+            return std::get_if<std::vector<T>>(&elements);
+        }
+
+        friend bool operator==(Array const& a, Array const& b);
+
+    };
+
+}
+
+
+#endif
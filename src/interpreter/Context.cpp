@@ -1,4 +1,6 @@
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -12,29 +14,75 @@
 
 namespace Interpreter {
 
-    Context::Context(std::shared_ptr<Parser::Expression> caller) :
-        caller(std::move(caller)) {}
+    Context::Context(std::shared_ptr<Parser::Expression> caller, std::shared_ptr<Parser::Scope const> scope) :
+        scope(std::move(scope)), caller(std::move(caller)) {
+        if (this->scope)
+            slots.resize(this->scope->symbols.size());
+    }
+
+    std::optional<IndirectReference>* Context::find_slot(std::string const& symbol) {
+        if (scope) {
+            auto slot = scope->get_slot(symbol);
+            if (slot < slots.size())
+                return &slots[slot];
+        }
+        return nullptr;
+    }
+
+    std::optional<IndirectReference>* Context::find_slot(Parser::Symbol const& symbol) {
+        if (scope && symbol.scope == scope)
+            return symbol.slot < slots.size() ? &slots[symbol.slot] : nullptr;
+        else
+            return find_slot(symbol.name);
+    }
 
     std::set<std::string> Context::get_symbols() const {
         std::set<std::string> symbols;
-        for (auto const& symbol : *this)
+        for (auto const& symbol : this->symbols)
             symbols.insert(symbol.first);
+        for (size_t i = 0; i < slots.size(); ++i)
+            if (slots[i])
+                symbols.insert(scope->symbols[i]);
         return symbols;
     }
 
-    bool Context::has_symbol(std::string const& symbol) const {
-        return symbols.find(symbol) != symbols.end();
+    bool Context::has_symbol(std::string const& symbol) {
+        if (auto* slot = find_slot(symbol))
+            return slot->has_value();
+        else
+            return symbols.find(symbol) != symbols.end();
+    }
+
+    bool Context::has_symbol(Parser::Symbol const& symbol) {
+        if (auto* slot = find_slot(symbol))
+            return slot->has_value();
+        else
+            return symbols.find(symbol.name) != symbols.end();
     }
 
     void Context::add_symbol(std::string const& symbol, IndirectReference const& indirect_reference) {
-        symbols.emplace(symbol, indirect_reference);
+        if (auto* slot = find_slot(symbol)) {
+            if (!*slot)
+                *slot = indirect_reference;
+        } else {
+            symbols.emplace(symbol, indirect_reference);
+        }
     }
 
     void Context::add_symbol(std::string const& symbol, Data const& data) {
-        symbols.emplace(symbol, GC::new_reference(data));
+        add_symbol(symbol, GC::new_reference(data));
     }
 
-    IndirectReference Context::operator[](std::string const& symbol) {
+    void Context::add_symbol(Parser::Symbol const& symbol, IndirectReference const& indirect_reference) {
+        if (auto* slot = find_slot(symbol)) {
+            if (!*slot)
+                *slot = indirect_reference;
+        } else {
+            symbols.emplace(symbol.name, indirect_reference);
+        }
+    }
+
+    IndirectReference Context::get_unscoped(std::string const& symbol) {
         auto it = symbols.find(symbol);
         if (it == symbols.end())
             return symbols.emplace(symbol, GC::new_reference()).first->second;
@@ -42,13 +90,54 @@ namespace Interpreter {
             return it->second;
     }
 
+    IndirectReference Context::operator[](std::string const& symbol) {
+        if (auto* slot = find_slot(symbol)) {
+            if (!*slot)
+                *slot = GC::new_reference();
+            return **slot;
+        } else {
+            return get_unscoped(symbol);
+        }
+    }
+
+    IndirectReference Context::operator[](Parser::Symbol const& symbol) {
+        if (auto* slot = find_slot(symbol)) {
+            if (!*slot)
+                *slot = GC::new_reference();
+            return **slot;
+        } else {
+            return get_unscoped(symbol.name);
+        }
+    }
+
+    void Context::bind_slot(size_t slot, IndirectReference const& indirect_reference) {
+        if (slot < slots.size() && !slots[slot])
+            slots[slot] = indirect_reference;
+    }
+
+
+    Builtin::Builtin(SymbolReference symbol) :
+        symbol(std::move(symbol)) {
+        if (auto const* object = get_if<ObjectPtr>(this->symbol.get()); object && !(*object)->functions.empty()) {
+            function = *object;
+            overload = &std::as_const(function->functions).front();
+        }
+    }
+
+    bool Builtin::is_intact() const {
+        auto const* object = function ? get_if<ObjectPtr>(symbol.get()) : nullptr;
+        return object && *object == function && !function->functions.empty() && &std::as_const(function->functions).front() == overload;
+    }
 
     GlobalContext::GlobalContext(std::shared_ptr<Parser::Expression> expression) :
         Context(std::move(expression)), system(GC::new_object()) {
         SystemFunctions::init(*this);
+
+        getter = Builtin(std::get<SymbolReference>((*this)["getter"]));
+        setter = Builtin(std::get<SymbolReference>((*this)["setter"]));
     }
 
-    FunctionContext::FunctionContext(Context& parent, std::shared_ptr<Parser::Expression> caller) :
-        Context(std::move(caller)), parent(parent), recursion_level(parent.get_recurion_level() + 1) {}
+    FunctionContext::FunctionContext(Context& parent, std::shared_ptr<Parser::Expression> caller, std::shared_ptr<Parser::Scope const> scope) :
+        Context(std::move(caller), std::move(scope)), parent(parent), global(parent.get_global()), recursion_level(parent.get_recurion_level() + 1) {}
 
 }
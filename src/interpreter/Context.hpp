@@ -3,11 +3,14 @@
 
 // IWYU pragma: private; include "Interpreter.hpp"
 
+#include <cstddef>
 #include <filesystem>
 #include <map>
 #include <memory>
+#include <optional>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "Data.hpp"
 #include "Reference.hpp"
@@ -15,23 +18,57 @@
 #include "../parser/Expressions.hpp"
 
 
+namespace Parser {
+
+    class Prefetcher;
+
+}
+
 namespace Interpreter {
 
     class Context;
     class GlobalContext;
+    struct Function;
     class FunctionContext;
 
+    /**
+     * The engines able to execute the expressions.
+    */
+    enum class Engine {
+        /**
+         * Walks the expression tree.
+        */
+        TreeWalker,
+        /**
+         * Compiles the expressions to bytecode and runs it in a dispatch loop.
+        */
+        VirtualMachine
+    };
+
     class Context {
 
     protected:
 
+        /**
+         * The scope of the context, its symbols are stored in the slots.
+        */
+        std::shared_ptr<Parser::Scope const> scope;
+        std::vector<std::optional<IndirectReference>> slots;
+
+        /**
+         * The symbols which are not in the scope of the context.
+        */
         std::map<std::string, IndirectReference> symbols;
 
+        std::optional<IndirectReference>* find_slot(std::string const& symbol);
+        std::optional<IndirectReference>* find_slot(Parser::Symbol const& symbol);
+        IndirectReference get_unscoped(std::string const& symbol);
+
     public:
 
         std::shared_ptr<Parser::Expression> caller;
 
-        Context(std::shared_ptr<Parser::Expression> caller);
+        Context(std::shared_ptr<Parser::Expression> caller, std::shared_ptr<Parser::Scope const> scope = nullptr);
         Context(Context const&) = delete;
         Context(Context&&) = delete;
 
@@ -43,25 +80,73 @@ namespace Interpreter {
         [[nodiscard]] virtual unsigned get_recurion_level() = 0;
 
         [[nodiscard]] std::set<std::string> get_symbols() const;
-        [[nodiscard]] bool has_symbol(std::string const& symbol) const;
+        [[nodiscard]] bool has_symbol(std::string const& symbol);
+        [[nodiscard]] bool has_symbol(Parser::Symbol const& symbol);
         void add_symbol(std::string const& symbol, IndirectReference const& indirect_reference);
         void add_symbol(std::string const& symbol, Data const& data);
+        void add_symbol(Parser::Symbol const& symbol, IndirectReference const& indirect_reference);
         IndirectReference operator[](std::string const& symbol);
-        [[nodiscard]] auto begin() const { return symbols.begin(); }
-        [[nodiscard]] auto end() const { return symbols.end(); }
+        IndirectReference operator[](Parser::Symbol const& symbol);
+
+        /**
+         * Binds a slot of the scope if it is not already bound.
+         * @param slot the slot.
+         * @param indirect_reference the reference to bind.
+        */
+        void bind_slot(size_t slot, IndirectReference const& indirect_reference);
 
         virtual ~Context() = default;
 
     };
 
+    /**
+     * A global function whose builtin overload the interpreter may inline, as long as the program did not override it.
+    */
+    class Builtin {
+
+        SymbolReference symbol;
+        ObjectPtr function;
+        Function const* overload = nullptr;
+
+    public:
+
+        Builtin() = default;
+        Builtin(SymbolReference symbol);
+
+        /**
+         * Tells if the symbol still holds the builtin function and if its builtin overload is still tried first.
+         * The overloads added after it by the operator | only get the arguments it rejects.
+         * @return true if the builtin overload is still tried first.
+        */
+        [[nodiscard]] bool is_intact() const;
+
+    };
+
     class GlobalContext : public Context {
 
     public:
 
         Data system;
 
+        /**
+         * The builtin getter and setter, which are bypassed while they are intact.
+        */
+        Builtin getter;
+        Builtin setter;
+
         std::map<std::filesystem::path, std::shared_ptr<Parser::Expression>> sources;
+
+        /**
+         * The symbol resolvers of the trees which imported files, the symbols of their next imported files are added to them.
+        */
+        std::map<std::weak_ptr<Parser::Expression>, Parser::SymbolResolver, std::owner_less<>> resolvers;
+
+        /**
+         * The parser of the files which are about to be imported, if the imports are prefetched.
+        */
+        std::shared_ptr<Parser::Prefetcher> prefetcher;
         unsigned recursion_limit = 100;
+        Engine engine = Engine::VirtualMachine;
 
         GlobalContext(std::shared_ptr<Parser::Expression> expression);
 
@@ -84,14 +169,15 @@ namespace Interpreter {
     protected:
 
         Context& parent;
+        GlobalContext& global;
         unsigned recursion_level;
 
     public:
 
-        FunctionContext(Context& parent, std::shared_ptr<Parser::Expression> caller);
+        FunctionContext(Context& parent, std::shared_ptr<Parser::Expression> caller, std::shared_ptr<Parser::Scope const> scope = nullptr);
 
         [[nodiscard]] GlobalContext& get_global() override {
-            return parent.get_global();
+            return global;
         }
 
         [[nodiscard]] Context& get_parent() override {
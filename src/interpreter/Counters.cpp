@@ -0,0 +1,87 @@
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string_view>
+
+#include "Counters.hpp"
+
+
+namespace Interpreter::Counters {
+
+    namespace {
+
+        struct Registry {
+            std::mutex mutex;
+            std::list<ThreadCounters> threads;
+            std::array<uint64_t, size> finished{};
+        };
+
+        Registry& get_registry() {
+            static Registry registry;
+            return registry;
+        }
+
+        /**
+         * Adds the counters of a thread to the ones of the finished threads when it exits.
+        */
+        struct ThreadExit {
+
+            std::list<ThreadCounters>::iterator counters;
+
+            ~ThreadExit() {
+                auto& registry = get_registry();
+                std::lock_guard lock(registry.mutex);
+                for (size_t i = 0; i < size; ++i)
+                    registry.finished[i] += counters->values[i].load(std::memory_order_relaxed);
+                registry.threads.erase(counters);
+                thread_counters = nullptr;
+            }
+
+        };
+
+    }
+
+    ThreadCounters* add_thread() {
+        auto& registry = get_registry();
+        std::list<ThreadCounters>::iterator it;
+        {
+            std::lock_guard lock(registry.mutex);
+            it = registry.threads.emplace(registry.threads.end());
+        }
+
+        thread_local ThreadExit const thread_exit{ it };
+        thread_counters = &*it;
+        return thread_counters;
+    }
+
+    std::array<uint64_t, size> get() {
+        auto& registry = get_registry();
+        std::lock_guard lock(registry.mutex);
+
+        auto counters = registry.finished;
+        for (auto const& thread : registry.threads)
+            for (size_t i = 0; i < size; ++i)
+                counters[i] += thread.values[i].load(std::memory_order_relaxed);
+        return counters;
+    }
+
+    std::string_view get_name(Counter counter) {
+        static constexpr std::array<std::string_view, size> names = {
+            "custom_calls",
+            "system_calls",
+            "overloads_tried",
+            "overloads_matched",
+            "getters",
+            "setters",
+            "objects",
+            "references",
+            "exceptions",
+            "imports"
+        };
+        return names[static_cast<size_t>(counter)];
+    }
+
+}
@@ -0,0 +1,92 @@
+#ifndef __INTERPRETER_COUNTERS_HPP__
+#define __INTERPRETER_COUNTERS_HPP__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+
+namespace Interpreter::Counters {
+
+    /**
+     * The events counted by the interpreter.
+    */
+    enum class Counter : size_t {
+        CustomCalls,
+        /**
+         * The calls to the system functions which accept their arguments, the ones which reject them are not counted.
+        */
+        SystemCalls,
+        /**
+         * The overloads whose parameters are bound to the arguments, the ones rejected by the dispatch cache are not counted.
+        */
+        OverloadsTried,
+        OverloadsMatched,
+        /**
+         * The calls to the functions getter and setter, the accesses resolved without calling them are not counted.
+        */
+        Getters,
+        Setters,
+        Objects,
+        References,
+        Exceptions,
+        /**
+         * The source files read and executed by an import, the imports of a file already executed are not counted.
+        */
+        Imports,
+        Size
+    };
+
+    constexpr size_t size = static_cast<size_t>(Counter::Size);
+
+    /**
+     * The counters of a thread, only the thread increments them so that no atomic read-modify-write is needed.
+     * The counters of a thread which exits are added to the ones of the finished threads.
+    */
+    struct ThreadCounters {
+        std::array<std::atomic<uint64_t>, size> values{};
+    };
+
+    /**
+     * The counters of the current thread, registered at its first event so that reading them needs no initialization guard.
+    */
+    inline thread_local constinit ThreadCounters* thread_counters = nullptr;
+
+    /**
+     * Registers the counters of the current thread.
+     * @return the counters.
+    */
+    [[nodiscard]] ThreadCounters* add_thread();
+
+    /**
+     * Counts an event in the current thread.
+     * @param counter the counter of the event.
+    */
+    inline void increment(Counter counter) {
+        auto* counters = thread_counters;
+        if (counters == nullptr)
+            counters = add_thread();
+
+        auto& value = counters->values[static_cast<size_t>(counter)];
+        value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Gets the counters of all the threads.
+     * @return the sum of the counters, indexed by Counter.
+    */
+    [[nodiscard]] std::array<uint64_t, size> get();
+
+    /**
+     * Gets the name of a counter.
+     * @param counter the counter.
+     * @return the name, as a snake case identifier.
+    */
+    [[nodiscard]] std::string_view get_name(Counter counter);
+
+}
+
+
+#endif
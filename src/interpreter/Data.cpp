@@ -1,39 +1,31 @@
 
-#include <any>
 #include <cstddef>
 #include <string>
-#include <typeindex>
-
-#include <ouverium/types.h>
 
 #include "Interpreter.hpp"
 
+#include "../parser/Expressions.hpp"
 
-namespace Interpreter {
 
-    Data::Comparators Data::comparators = {
-        Data::SimpleComparator<ObjectPtr, ObjectPtr>,
-        Data::SimpleComparator<char, char>,
-        Data::SimpleComparator<OV_FLOAT, OV_FLOAT>,
-        Data::SimpleComparator<OV_INT, OV_INT>,
-        Data::SimpleComparator<bool, bool>,
-    };
-
-    bool operator==(Data const& a, Data const& b) {
-        if (!static_cast<std::any const&>(a).has_value() && !static_cast<std::any const&>(b).has_value())
-            return true;
-
-        auto it = Data::comparators.find({ std::type_index(static_cast<std::any const&>(a).type()), std::type_index(static_cast<std::any const&>(b).type()) });
-        if (it != Data::comparators.end())
-            return it->second(a, b);
-        else
-            return false;
-    }
+namespace Interpreter {
 
     PropertyReference Data::get_property(std::string const& name) {
         return PropertyReference{ .parent = *this, .name = name };
     }
 
+    PropertyReference Data::get_property(Parser::Property const& property) {
+        PropertyReference reference{ .parent = *this, .name = property.name };
+        if (auto const* object = get_if<ObjectPtr>(this)) {
+            auto const& properties = (*object)->properties;
+            auto slot = properties.find_slot(property);
+            if (slot < properties.get_shape().size()) {
+                reference.shape_id = properties.get_shape().get_id();
+                reference.slot = slot;
+            }
+        }
+        return reference;
+    }
+
     ArrayReference Data::get_at(size_t index) {
         return ArrayReference{ .array = *this, .i = index };
     }
@@ -3,19 +3,21 @@
 
 // IWYU pragma: private; include "Interpreter.hpp"
 
-#include <any>
 #include <cstddef>
+#include <cstdint>
 #include <exception>
-#include <functional>
-#include <map>
 #include <memory>
 #include <string>
-#include <typeindex>
+#include <type_traits>
 #include <utility>
 
 #include <ouverium/types.h>
 
 
+namespace Parser {
+    struct Property;
+}
+
 namespace Interpreter {
 
     struct Object;
@@ -24,80 +26,141 @@ namespace Interpreter {
 
     using ObjectPtr = std::shared_ptr<Object>;
 
-    class Data : protected std::any {
+    /**
+     * A value of the language, which is either empty, an object, a char, a float, an integer or a boolean.
+     * The scalar values are stored inline next to a tag, the objects in a dedicated pointer slot.
+    */
+    class Data {
 
     public:
 
-        using Comparators = std::map<std::pair<std::type_index, std::type_index>, std::function<bool(std::any const&, std::any const&)>>;
-        using Comparator = std::pair<std::pair<std::type_index, std::type_index>, std::function<bool(std::any const&, std::any const&)>>;
+        /**
+         * The kinds of values a data can hold.
+        */
+        enum class Type : uint8_t {
+            Empty,
+            Object,
+            Char,
+            Float,
+            Int,
+            Bool
+        };
 
-        static Comparators comparators;
+    private:
 
-        template<typename T, typename U>
-        static inline Comparator SimpleComparator = {
-            {std::type_index(typeid(T)), std::type_index(typeid(U))},
-            [](std::any const& a, std::any const& b) {
-                return std::any_cast<T>(a) == std::any_cast<U>(b);
-            }
+        Type type = Type::Empty;
+        union {
+            OV_INT i = 0;
+            OV_FLOAT f;
+            char c;
+            bool b;
         };
+        ObjectPtr object;
 
+        template<typename T>
+        [[nodiscard]] static constexpr Type type_of() {
+            if constexpr (std::is_same_v<T, ObjectPtr>)
+                return Type::Object;
+            else if constexpr (std::is_same_v<T, char>)
+                return Type::Char;
+            else if constexpr (std::is_same_v<T, OV_FLOAT>)
+                return Type::Float;
+            else if constexpr (std::is_same_v<T, OV_INT>)
+                return Type::Int;
+            else if constexpr (std::is_same_v<T, bool>)
+                return Type::Bool;
+            else
+                static_assert(!sizeof(T), "a data can only hold an object, a char, a float, an integer or a boolean");
+        }
+
+    public:
 
         Data() = default;
-        explicit Data(ObjectPtr object) : std::any(object) {}
-        explicit Data(char c) : std::any(c) {}
-        explicit Data(OV_FLOAT f) : std::any(f) {}
-        explicit Data(OV_INT i) : std::any(i) {}
-        explicit Data(bool b) : std::any(b) {}
-        explicit Data(std::any const& any) : std::any(any) {}
+        explicit Data(ObjectPtr object) : type(Type::Object), object(std::move(object)) {}
+        explicit Data(char c) : type(Type::Char), c(c) {}
+        explicit Data(OV_FLOAT f) : type(Type::Float), f(f) {}
+        explicit Data(OV_INT i) : type(Type::Int), i(i) {}
+        explicit Data(bool b) : type(Type::Bool), b(b) {}
 
         Data& operator=(ObjectPtr object) {
-            static_cast<std::any&>(*this) = object;
-            return *this;
+            return *this = Data(std::move(object));
         }
         Data& operator=(char c) {
-            static_cast<std::any&>(*this) = c;
-            return *this;
+            return *this = Data(c);
         }
         Data& operator=(OV_FLOAT f) {
-            static_cast<std::any&>(*this) = f;
-            return *this;
+            return *this = Data(f);
         }
         Data& operator=(OV_INT i) {
-            static_cast<std::any&>(*this) = i;
-            return *this;
+            return *this = Data(i);
         }
         Data& operator=(bool b) {
-            static_cast<std::any&>(*this) = b;
-            return *this;
+            return *this = Data(b);
         }
-        Data& operator=(std::any const& any) {
-            static_cast<std::any&>(*this) = any;
-            return *this;
+
+        [[nodiscard]] Type get_type() const {
+            return type;
         }
 
-        friend bool operator==(Data const& a, Data const& b);
+        [[nodiscard]] friend bool operator==(Data const& a, Data const& b) {
+            if (a.type != b.type)
+                return false;
+
+            switch (a.type) {
+            case Type::Object:
+                return a.object == b.object;
+            case Type::Char:
+                return a.c == b.c;
+            case Type::Float:
+                return a.f == b.f;
+            case Type::Int:
+                return a.i == b.i;
+            case Type::Bool:
+                return a.b == b.b;
+            default:
+                return true;
+            }
+        }
 
         class BadAccess : public std::exception {};
 
         template<typename T>
         [[nodiscard]] T const& get() const {
-            try {
-                return std::any_cast<T const&>(*this);
-            } catch (std::bad_any_cast const&) {
+            if (auto const* t = get_if<T>(this))
+                return *t;
+            else
                 throw BadAccess();
-            }
         }
         template<typename T>
         [[nodiscard]] friend T const* get_if(Data const* data) {
-            return std::any_cast<T const>(data);
+            if (data == nullptr || data->type != type_of<T>())
+                return nullptr;
+
+            if constexpr (std::is_same_v<T, ObjectPtr>)
+                return &data->object;
+            else if constexpr (std::is_same_v<T, char>)
+                return &data->c;
+            else if constexpr (std::is_same_v<T, OV_FLOAT>)
+                return &data->f;
+            else if constexpr (std::is_same_v<T, OV_INT>)
+                return &data->i;
+            else
+                return &data->b;
         }
         template<typename T>
         [[nodiscard]] bool is() const {
-            return std::any_cast<T const>(this);
+            return type == type_of<T>();
         }
 
         [[nodiscard]] PropertyReference get_property(std::string const& name);
 
+        /**
+         * Gets a reference to a property, with the slot of the property found through the inline cache of the expression.
+         * @param property the property expression.
+         * @return the property reference.
+        */
+        [[nodiscard]] PropertyReference get_property(Parser::Property const& property);
+
         [[nodiscard]] ArrayReference get_at(size_t index);
 
     };
@@ -3,11 +3,19 @@
 
 // IWYU pragma: private; include "Interpreter.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <typeinfo>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include "Reference.hpp"
 
@@ -22,19 +30,224 @@ namespace Interpreter {
 
     struct SystemFunction {
         std::shared_ptr<Parser::Expression> parameters;
-        std::function<Reference(FunctionContext&)> pointer;
+
+        /**
+         * The native function, which returns nothing when it rejects its arguments so that the next overload is tried.
+        */
+        std::function<std::optional<Reference>(FunctionContext&)> pointer;
+
+        /**
+         * Tells if two native functions both hold the same function pointer of type F, or both do not hold a function pointer of type F.
+        */
+        template<typename F>
+        [[nodiscard]] static bool has_same_target(SystemFunction const& a, SystemFunction const& b) {
+            auto const* f = a.pointer.target<F>();
+            auto const* g = b.pointer.target<F>();
+            return f == g || (f != nullptr && g != nullptr && *f == *g);
+        }
 
         [[nodiscard]] friend bool operator==(SystemFunction const& a, SystemFunction const& b) {
-            return a.parameters == b.parameters && a.pointer.target<Reference(*)(FunctionContext&)>() == b.pointer.target<Reference(*)(FunctionContext&)>();
+            return a.parameters == b.parameters
+                && a.pointer.target_type() == b.pointer.target_type()
+                && has_same_target<Reference(*)(FunctionContext&)>(a, b)
+                && has_same_target<std::optional<Reference>(*)(FunctionContext&)>(a, b);
         }
     };
 
     struct Function : public std::variant<CustomFunction, SystemFunction> {
         std::map<std::string, IndirectReference> extern_symbols;
 
+        /**
+         * The captured symbols, bound to their slot in the scope of the function definition.
+        */
+        std::vector<std::pair<size_t, IndirectReference>> captures;
+
         using std::variant<CustomFunction, SystemFunction>::variant;
     };
 
+    /**
+     * The overloads of a function, with a version which changes each time an overload is added or removed.
+     * The versions are unique to all the lists, two lists with the same version are copies holding the same overloads, so that the dispatch caches of the calls only need the version they were made from.
+    */
+    class FunctionList : private std::list<Function> {
+
+        static inline std::atomic<uint64_t> versions = 0;
+
+        uint64_t version = 0;
+
+        /**
+         * An immutable copy of the overloads, made at the first call after a change and shared by the calls until the next change.
+        */
+        mutable std::atomic<std::shared_ptr<std::vector<Function> const>> snapshot;
+
+        void change() {
+            version = versions.fetch_add(1, std::memory_order_relaxed) + 1;
+            snapshot.store(nullptr, std::memory_order_release);
+        }
+
+    public:
+
+        using std::list<Function>::iterator;
+        using std::list<Function>::const_iterator;
+        using std::list<Function>::begin;
+        using std::list<Function>::end;
+        using std::list<Function>::rbegin;
+        using std::list<Function>::rend;
+        using std::list<Function>::size;
+        using std::list<Function>::empty;
+
+        FunctionList() = default;
+        FunctionList(FunctionList const& list) :
+            std::list<Function>(list), version(list.version) {}
+        FunctionList(FunctionList&& list) noexcept :
+            std::list<Function>(std::move(list)), version(list.version) {
+            list.change();
+        }
+
+        FunctionList& operator=(FunctionList const& list) {
+            if (this != &list) {
+                std::list<Function>::operator=(list);
+                version = list.version;
+                clear_snapshot();
+            }
+            return *this;
+        }
+        FunctionList& operator=(FunctionList&& list) noexcept {
+            if (this != &list) {
+                std::list<Function>::operator=(std::move(list));
+                version = list.version;
+                clear_snapshot();
+                list.change();
+            }
+            return *this;
+        }
+
+        ~FunctionList() = default;
+
+        [[nodiscard]] uint64_t get_version() const {
+            return version;
+        }
+
+        /**
+         * Gets the overloads as they are now, the copy stays valid while the list changes.
+         * @return the copy of the overloads.
+        */
+        [[nodiscard]] std::shared_ptr<std::vector<Function> const> get_snapshot() const {
+            auto functions = snapshot.load(std::memory_order_acquire);
+            if (!functions) {
+                functions = std::make_shared<std::vector<Function> const>(begin(), end());
+                snapshot.store(functions, std::memory_order_release);
+            }
+            return functions;
+        }
+
+        /**
+         * Frees the copy of the overloads, so that the references it captures are only held by the list.
+        */
+        void clear_snapshot() const {
+            snapshot.store(nullptr, std::memory_order_release);
+        }
+
+        [[nodiscard]] Function const& front() const {
+            return std::list<Function>::front();
+        }
+
+        [[nodiscard]] Function const& back() const {
+            return std::list<Function>::back();
+        }
+
+        /**
+         * Gets the first overload to modify it, its parameters must not change.
+        */
+        [[nodiscard]] Function& front() {
+            clear_snapshot();
+            return std::list<Function>::front();
+        }
+
+        /**
+         * Gets the last overload to modify it, its parameters must not change.
+        */
+        [[nodiscard]] Function& back() {
+            clear_snapshot();
+            return std::list<Function>::back();
+        }
+
+        /**
+         * Compares the overloads, the versions are ignored.
+        */
+        friend bool operator==(FunctionList const& a, FunctionList const& b) {
+            return static_cast<std::list<Function> const&>(a) == static_cast<std::list<Function> const&>(b);
+        }
+
+        void push_front(Function const& function) {
+            change();
+            std::list<Function>::push_front(function);
+        }
+
+        void push_back(Function const& function) {
+            change();
+            std::list<Function>::push_back(function);
+        }
+
+        template<typename... Args>
+        Function& emplace_front(Args&&... args) {
+            change();
+            return std::list<Function>::emplace_front(std::forward<Args>(args)...);
+        }
+
+        template<typename... Args>
+        Function& emplace_back(Args&&... args) {
+            change();
+            return std::list<Function>::emplace_back(std::forward<Args>(args)...);
+        }
+
+        void clear() {
+            change();
+            std::list<Function>::clear();
+        }
+
+        /**
+         * Moves an overload of a list at the end of this one, the overload is not copied.
+         * @param list the list of the overload.
+         * @param it the overload.
+        */
+        void splice_back(std::list<Function>& list, std::list<Function>::const_iterator it) {
+            change();
+            std::list<Function>::splice(std::list<Function>::end(), list, it);
+        }
+
+        /**
+         * Exchanges the overloads with the ones of a list, the overloads are not copied.
+         * @param list the list.
+        */
+        void swap(std::list<Function>& list) {
+            change();
+            std::list<Function>::swap(list);
+        }
+
+    };
+
+    /**
+     * The dispatch cache of a call, for each of its last callees the overloads whose parameters may match the arguments.
+     * A cache holds no overload, so that it keeps alive neither the callees nor their captures, and is never modified once it is shared, the call replaces it when a callee or its overloads change.
+    */
+    struct DispatchCache {
+
+        struct Entry {
+            /**
+             * The version of the overloads of the callee, which identifies them without keeping the callee alive.
+            */
+            uint64_t version = 0;
+            /**
+             * The indices of the overloads which may match in the list of the callee at this version, in the order to try them.
+            */
+            std::vector<size_t> candidates;
+        };
+
+        std::vector<Entry> entries;
+
+    };
+
 }
 
 
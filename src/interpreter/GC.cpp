@@ -1,20 +1,281 @@
-#include <cassert>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
 
+#include "Arena.hpp"
+#include "Counters.hpp"
 #include "Interpreter.hpp"
 
 
 namespace Interpreter::GC {
 
+    namespace {
+
+        constexpr size_t minimum_threshold = 1 << 16;
+        constexpr size_t minimum_purge = 1 << 10;
+
+        /**
+         * The objects and the references allocated by the collector.
+        */
+        struct Heap {
+            Arena objects_arena{ "objects" };
+            Arena references_arena{ "references" };
+
+            std::mutex mutex;
+            std::vector<std::weak_ptr<Object>> objects;
+            std::vector<std::weak_ptr<Data>> references;
+
+            /**
+             * The number of allocations since the last collection, a collection is triggered when it reaches the threshold.
+            */
+            size_t allocations = 0;
+            size_t threshold = minimum_threshold;
+
+            /**
+             * The number of tracked nodes from which the expired ones are purged, so that their blocks return to the arenas.
+            */
+            size_t purge = minimum_purge;
+
+            std::atomic<unsigned> threads = 0;
+        };
+
+        Heap& get_heap() {
+            // Never destroyed, the objects which outlive the interpreter still need their arenas
+            static auto* heap = new Heap();
+            return *heap;
+        }
+
+        void purge(Heap& heap) {
+            std::erase_if(heap.objects, [](auto const& object) { return object.expired(); });
+            std::erase_if(heap.references, [](auto const& reference) { return reference.expired(); });
+            heap.purge = std::max(minimum_purge, 2 * (heap.objects.size() + heap.references.size()));
+        }
+
+        /**
+         * Tracks a new node and triggers a collection or a purge if needed.
+        */
+        template<typename T>
+        void track(Heap& heap, std::vector<std::weak_ptr<T>>& nodes, std::shared_ptr<T> const& node) {
+            std::unique_lock lock(heap.mutex);
+            nodes.push_back(node);
+            if (++heap.allocations >= heap.threshold) {
+                lock.unlock();
+                collect();
+            } else if (heap.objects.size() + heap.references.size() >= heap.purge) {
+                purge(heap);
+            }
+        }
+
+        template<typename T>
+        std::vector<std::shared_ptr<T>> lock_all(std::vector<std::weak_ptr<T>>& pointers) {
+            std::vector<std::shared_ptr<T>> locked;
+            locked.reserve(pointers.size());
+            for (auto const& pointer : pointers)
+                if (auto p = pointer.lock())
+                    locked.push_back(std::move(p));
+
+            pointers.assign(locked.begin(), locked.end());
+            return locked;
+        }
+
+        /**
+         * A collection of the heap.
+         * The nodes are the objects followed by the references, the edges are the shared pointers stored in the nodes.
+        */
+        class Collection {
+
+            std::vector<ObjectPtr> objects;
+            std::vector<SymbolReference> references;
+            std::unordered_map<void const*, size_t> indices;
+
+            template<typename F>
+            static void for_each_child(Data const& data, F const& f) {
+                if (auto const* object = get_if<ObjectPtr>(&data))
+                    f(object->get());
+            }
+
+            template<typename F>
+            static void for_each_child(IndirectReference const& reference, F const& f) {
+                if (auto const* symbol_reference = std::get_if<SymbolReference>(&reference))
+                    f(symbol_reference->get());
+                else if (auto const* property_reference = std::get_if<PropertyReference>(&reference))
+                    for_each_child(property_reference->parent, f);
+                else if (auto const* array_reference = std::get_if<ArrayReference>(&reference))
+                    for_each_child(array_reference->array, f);
+            }
+
+            template<typename F>
+            static void for_each_child(Object const& object, F const& f) {
+                for (auto const& data : object.properties.get_values())
+                    for_each_child(data, f);
+                if (auto const* array = object.array.get_vector())
+                    for (auto const& data : *array)
+                        for_each_child(data, f);
+                for (auto const& function : object.functions) {
+                    for (auto const& symbol : function.extern_symbols)
+                        for_each_child(symbol.second, f);
+                    for (auto const& capture : function.captures)
+                        for_each_child(capture.second, f);
+                }
+            }
+
+            template<typename F>
+            void for_each_child(size_t node, F const& f) const {
+                auto const g = [this, &f](void const* child) {
+                    auto it = indices.find(child);
+                    if (it != indices.end())
+                        f(it->second);
+                };
+
+                if (node < objects.size())
+                    for_each_child(*objects[node], g);
+                else
+                    for_each_child(*references[node - objects.size()], g);
+            }
+
+            [[nodiscard]] size_t size() const {
+                return objects.size() + references.size();
+            }
+
+            [[nodiscard]] long use_count(size_t node) const {
+                if (node < objects.size())
+                    return objects[node].use_count();
+                else
+                    return references[node - objects.size()].use_count();
+            }
+
+        public:
+
+            Collection(Heap& heap) :
+                objects(lock_all(heap.objects)), references(lock_all(heap.references)) {
+                indices.reserve(size());
+                for (size_t i = 0; i < objects.size(); ++i) {
+                    // The copies of the overloads are not edges, the references they capture would be taken for roots
+                    objects[i]->functions.clear_snapshot();
+                    indices.emplace(objects[i].get(), i);
+                }
+                for (size_t i = 0; i < references.size(); ++i)
+                    indices.emplace(references[i].get(), objects.size() + i);
+            }
+
+            /**
+             * Frees the unreachable nodes.
+             * @return the number of remaining nodes.
+            */
+            size_t sweep() {
+                // The nodes still referenced once the references from the heap are removed are the roots
+                std::vector<long> counts(size());
+                for (size_t i = 0; i < size(); ++i)
+                    counts[i] = use_count(i) - 1;
+                for (size_t i = 0; i < size(); ++i)
+                    for_each_child(i, [&counts](size_t child) {
+                        --counts[child];
+                    });
+
+                std::vector<bool> reached(size());
+                std::vector<size_t> stack;
+                for (size_t i = 0; i < size(); ++i)
+                    if (counts[i] > 0) {
+                        reached[i] = true;
+                        stack.push_back(i);
+                    }
+                while (!stack.empty()) {
+                    auto node = stack.back();
+                    stack.pop_back();
+                    for_each_child(node, [&reached, &stack](size_t child) {
+                        if (!reached[child]) {
+                            reached[child] = true;
+                            stack.push_back(child);
+                        }
+                    });
+                }
+
+                // The unreachable nodes are emptied to break their cycles, they are destroyed with the collection
+                std::vector<Object> objects_garbage;
+                std::vector<Data> references_garbage;
+                size_t remaining = 0;
+                for (size_t i = 0; i < size(); ++i) {
+                    if (reached[i])
+                        ++remaining;
+                    else if (i < objects.size())
+                        objects_garbage.push_back(std::exchange(*objects[i], Object{}));
+                    else
+                        references_garbage.push_back(std::exchange(*references[i - objects.size()], Data{}));
+                }
+                return remaining;
+            }
+
+        };
+
+    }
+
     ObjectPtr new_object(Object const& object) {
-        return std::make_shared<Object>(object);
+        auto& heap = get_heap();
+        Counters::increment(Counters::Counter::Objects);
+        auto ptr = std::allocate_shared<Object>(ArenaAllocator<Object>(heap.objects_arena), object);
+        track(heap, heap.objects, ptr);
+        return ptr;
     }
 
     SymbolReference new_reference(Data const& data) {
-        return { std::make_shared<Data>(data) };
+        auto& heap = get_heap();
+        Counters::increment(Counters::Counter::References);
+        auto ptr = std::allocate_shared<Data>(ArenaAllocator<Data>(heap.references_arena), data);
+        track(heap, heap.references, ptr);
+        return ptr;
     }
 
     void collect() {
+        auto& heap = get_heap();
+
+        std::unique_lock lock(heap.mutex);
+        heap.allocations = 0;
+
+        if (heap.threads > 0) {
+            purge(heap);
+            heap.threshold = std::max(minimum_threshold, 2 * (heap.objects.size() + heap.references.size()));
+            return;
+        }
+
+        size_t remaining = 0;
+        {
+            Collection collection(heap);
+            lock.unlock();
+
+            remaining = collection.sweep();
+        }
 
+        lock.lock();
+        purge(heap);
+        heap.threshold = std::max(minimum_threshold, 2 * remaining);
+        lock.unlock();
+
+        heap.objects_arena.release();
+        heap.references_arena.release();
+    }
+
+    std::vector<ArenaStatistics> get_statistics() {
+        auto& heap = get_heap();
+        return { heap.objects_arena.get_statistics(), heap.references_arena.get_statistics() };
+    }
+
+    ThreadGuard::ThreadGuard() {
+        ++get_heap().threads;
     }
+
+    ThreadGuard::ThreadGuard(ThreadGuard&& guard) noexcept {
+        guard.active = false;
+    }
+
+    ThreadGuard::~ThreadGuard() {
+        if (active)
+            --get_heap().threads;
+    }
+
 }
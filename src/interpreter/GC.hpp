@@ -3,6 +3,9 @@
 
 // IWYU pragma: private; include "Interpreter.hpp"
 
+#include <vector>
+
+#include "Arena.hpp"
 #include "Data.hpp"
 #include "Object.hpp"
 #include "Reference.hpp"
@@ -13,8 +16,39 @@ namespace Interpreter::GC {
     [[nodiscard]] ObjectPtr new_object(Object const& object = {});
     [[nodiscard]] SymbolReference new_reference(Data const& data = {});
 
+    /**
+     * Frees the objects and the references which are only reachable from unreachable cycles.
+     * The roots are the objects and references held outside of the heap, such as the contexts, the references being computed or the native objects.
+     * Nothing is collected while interpreter threads are running.
+    */
     void collect();
 
+    /**
+     * Gets the statistics of the arenas of the objects and of the references.
+     * @return the statistics of each arena.
+    */
+    [[nodiscard]] std::vector<ArenaStatistics> get_statistics();
+
+    /**
+     * Registers an interpreter thread until it is destroyed, the collections are disabled meanwhile.
+    */
+    class ThreadGuard {
+
+        bool active = true;
+
+    public:
+
+        ThreadGuard();
+        ThreadGuard(ThreadGuard const&) = delete;
+        ThreadGuard(ThreadGuard&& guard) noexcept;
+
+        ThreadGuard& operator=(ThreadGuard const&) = delete;
+        ThreadGuard& operator=(ThreadGuard&&) = delete;
+
+        ~ThreadGuard();
+
+    };
+
 }
 
 
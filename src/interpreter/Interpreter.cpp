@@ -1,8 +1,8 @@
 #include <cstddef>
 #include <iostream>
-#include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -10,17 +10,20 @@
 
 #include <ouverium/types.h>
 
+#include "Counters.hpp"
 #include "Interpreter.hpp"
+#include "Profiler.hpp"
+#include "VirtualMachine.hpp"
 
 #include "../parser/Expressions.hpp"
 
-#include "../Types.hpp"
-
 
 namespace Interpreter {
 
     Exception::Exception(Context& context, std::shared_ptr<Parser::Expression> const& thrower, Reference reference) :
         reference(std::move(reference)) {
+        Counters::increment(Counters::Counter::Exceptions);
+
         if (thrower)
             positions.push_back(thrower->position);
         Context* old_c = nullptr;
@@ -77,24 +80,137 @@ namespace Interpreter {
 
     };
 
-    void set_arguments(Context& context, FunctionContext& function_context, Computed& computed, std::shared_ptr<Parser::Expression> const& parameters, Arguments const& argument) {
+    namespace {
+
+        /**
+         * Tells if some parameters may match some arguments, that is to say if set_arguments would not reject them before evaluating anything.
+         * @param parameters the parameters.
+         * @param arguments the arguments expression.
+         * @return false if the parameters can never match the arguments, whatever their values.
+        */
+        bool may_match(Parser::Expression const& parameters, Parser::Expression const& arguments) {
+            if (auto const* p_tuple = dynamic_cast<Parser::Tuple const*>(&parameters)) {
+                if (auto const* a_tuple = dynamic_cast<Parser::Tuple const*>(&arguments)) {
+                    if (p_tuple->objects.size() != a_tuple->objects.size())
+                        return false;
+                    for (size_t i = 0; i < p_tuple->objects.size(); ++i)
+                        if (!may_match(*p_tuple->objects[i], *a_tuple->objects[i]))
+                            return false;
+                }
+                return true;
+            } else
+                return dynamic_cast<Parser::Symbol const*>(&parameters) || dynamic_cast<Parser::FunctionCall const*>(&parameters) || dynamic_cast<Parser::Property const*>(&parameters);
+        }
+
+        /**
+         * Makes the overloads to try for a call.
+         * @param function_call the call, or null if the arguments are not the expression of a call.
+         * @param version the version of the overloads.
+         * @param functions the overloads.
+         * @return the indices of the overloads which may match the call.
+        */
+        DispatchCache::Entry make_entry(Parser::FunctionCall const* function_call, uint64_t version, std::vector<Function> const& functions) {
+            DispatchCache::Entry entry;
+            entry.version = version;
+
+            for (size_t i = 0; i < functions.size(); ++i) {
+                auto const& function = functions[i];
+                if (function_call) {
+                    if (auto const* custom_function = std::get_if<CustomFunction>(&function); custom_function && !may_match(*(*custom_function)->parameters, *function_call->arguments))
+                        continue;
+                    if (auto const* system_function = std::get_if<SystemFunction>(&function); system_function && !may_match(*system_function->parameters, *function_call->arguments))
+                        continue;
+                }
+                entry.candidates.push_back(i);
+            }
+            return entry;
+        }
+
+        /**
+         * Gets the overloads to try for a call, through the dispatch cache of the call.
+         * The cache keeps, for the last callees of the call, the overloads which may match the arguments of the call until the overloads change.
+         * @param function_call the call, or null if the arguments are not the expression of a call.
+         * @param callee the object holding the overloads.
+         * @param functions the overloads of the callee.
+         * @return the cache and the entry of the callee.
+        */
+        std::pair<std::shared_ptr<DispatchCache const>, DispatchCache::Entry const*> get_overloads(Parser::FunctionCall const* function_call, ObjectPtr const& callee, std::vector<Function> const& functions) {
+            constexpr size_t max_entries = 4;
+
+            auto const version = callee->functions.get_version();
+
+            std::shared_ptr<DispatchCache const> cache;
+            if (function_call) {
+                cache = function_call->dispatch.load(std::memory_order_acquire);
+                if (cache)
+                    for (auto const& entry : cache->entries)
+                        if (entry.version == version)
+                            return { cache, &entry };
+            }
+
+            auto updated = std::make_shared<DispatchCache>();
+            updated->entries.push_back(make_entry(function_call, version, functions));
+            if (function_call) {
+                if (cache)
+                    for (auto const& entry : cache->entries)
+                        if (updated->entries.size() < max_entries)
+                            updated->entries.push_back(entry);
+                function_call->dispatch.store(updated, std::memory_order_release);
+            }
+            return { updated, &updated->entries.front() };
+        }
+
+        /**
+         * Gets the object holding the overloads of a function, through function_getter if the reference has no overload.
+         * @param context the context of the call.
+         * @param caller the caller expression.
+         * @param func the function reference.
+         * @return the object holding the overloads, or null if there is none.
+        */
+        ObjectPtr get_callee(Context& context, std::shared_ptr<Parser::Expression> const& caller, Reference const& func) {
+            auto data = func.to_data(context, caller);
+            if (auto const* object = get_if<ObjectPtr>(&data); object && !(*object)->functions.empty())
+                return *object;
+
+            data = call_function(context, caller, context.get_global()["function_getter"], func).to_data(context);
+            if (auto const* object = get_if<ObjectPtr>(&data))
+                return *object;
+            else
+                return nullptr;
+        }
+
+        std::optional<Reference> call_overloads(Context& context, std::shared_ptr<Parser::Expression> const& caller, ObjectPtr const& callee, Arguments const& arguments);
+
+    }
+
+    /**
+     * Binds the arguments of a call to the parameters of an overload.
+     * @param context the context of the call.
+     * @param function_context the context of the overload.
+     * @param computed the arguments already computed by the previous overloads.
+     * @param parameters the parameters of the overload.
+     * @param argument the arguments.
+     * @return false if the parameters do not match the arguments.
+    */
+    [[nodiscard]] bool set_arguments(Context& context, FunctionContext& function_context, Computed& computed, std::shared_ptr<Parser::Expression> const& parameters, Arguments const& argument) {
         auto arguments = computed.get(argument);
 
         if (auto symbol = std::dynamic_pointer_cast<Parser::Symbol>(parameters)) {
             auto reference = computed.compute(context, arguments);
 
-            if (function_context.has_symbol(symbol->name)) {
-                if (reference != Reference(function_context[symbol->name]))
-                    throw Interpreter::FunctionArgumentsError();
+            if (function_context.has_symbol(*symbol)) {
+                return reference == Reference(function_context[*symbol]);
             } else {
-                function_context.add_symbol(symbol->name, reference.to_indirect_reference(context, parameters));
+                function_context.add_symbol(*symbol, reference.to_indirect_reference(context, parameters));
+                return true;
             }
         } else if (auto p_tuple = std::dynamic_pointer_cast<Parser::Tuple>(parameters)) {
             if (auto* expression = std::get_if<ParserExpression>(&arguments)) {
                 if (auto a_tuple = std::dynamic_pointer_cast<Parser::Tuple>(*expression)) {
                     if (p_tuple->objects.size() == a_tuple->objects.size()) {
                         for (size_t i = 0; i < p_tuple->objects.size(); ++i)
-                            set_arguments(context, function_context, computed, p_tuple->objects[i], a_tuple->objects[i]);
+                            if (!set_arguments(context, function_context, computed, p_tuple->objects[i], a_tuple->objects[i]))
+                                return false;
 
                         TupleReference cache;
                         for (auto const& o : a_tuple->objects) {
@@ -102,36 +218,38 @@ namespace Interpreter {
                             if (it != computed.end())
                                 cache.push_back(it->second);
                             else
-                                return;
+                                return true;
                         }
                         computed[a_tuple] = cache;
+                        return true;
                     } else
-                        throw Interpreter::FunctionArgumentsError();
+                        return false;
                 } else {
-                    set_arguments(context, function_context, computed, parameters, computed.compute(context, arguments));
+                    return set_arguments(context, function_context, computed, parameters, computed.compute(context, arguments));
                 }
             } else if (auto* reference = std::get_if<Reference>(&arguments)) {
                 if (auto* tuple_reference = std::get_if<TupleReference>(reference)) {
                     if (tuple_reference->size() == p_tuple->objects.size()) {
                         for (size_t i = 0; i < p_tuple->objects.size(); ++i)
-                            set_arguments(context, function_context, computed, p_tuple->objects[i], (*tuple_reference)[i]);
+                            if (!set_arguments(context, function_context, computed, p_tuple->objects[i], (*tuple_reference)[i]))
+                                return false;
+                        return true;
                     } else
-                        throw Interpreter::FunctionArgumentsError();
+                        return false;
                 } else {
-                    try {
-                        auto object = reference->to_data(function_context, parameters).get<ObjectPtr>();
-                        if (object->array.capacity() > 0 && object->array.size() == p_tuple->objects.size()) {
-                            for (size_t i = 0; i < p_tuple->objects.size(); ++i)
-                                set_arguments(context, function_context, computed, p_tuple->objects[i], Data(object).get_at(i));
-                        } else
-                            throw Interpreter::FunctionArgumentsError();
-                    } catch (Data::BadAccess const&) {
-                        throw Interpreter::FunctionArgumentsError();
-                    }
+                    auto data = reference->to_data(function_context, parameters);
+                    if (auto const* object = get_if<ObjectPtr>(&data); object && (*object)->array.capacity() > 0 && (*object)->array.size() == p_tuple->objects.size()) {
+                        for (size_t i = 0; i < p_tuple->objects.size(); ++i)
+                            if (!set_arguments(context, function_context, computed, p_tuple->objects[i], data.get_at(i)))
+                                return false;
+                        return true;
+                    } else
+                        return false;
                 }
-            }
+            } else
+                return false;
         } else if (auto p_function = std::dynamic_pointer_cast<Parser::FunctionCall>(parameters)) {
-            if (auto symbol = std::dynamic_pointer_cast<Parser::Symbol>(p_function->function); symbol && !function_context.has_symbol(symbol->name)) {
+            if (auto symbol = std::dynamic_pointer_cast<Parser::Symbol>(p_function->function); symbol && !function_context.has_symbol(*symbol)) {
                 ObjectPtr object = GC::new_object();
                 auto function_definition = std::make_shared<Parser::FunctionDefinition>();
                 function_definition->parameters = p_function->arguments;
@@ -140,6 +258,7 @@ namespace Interpreter {
                     auto it = computed.find(*expression);
                     if (it == computed.end()) {
                         function_definition->body = *expression;
+                        function_definition->function_scope = (*expression)->scope;
 
                         object->functions.emplace_front(CustomFunction{ function_definition });
                         auto& f = object->functions.back();
@@ -181,7 +300,8 @@ namespace Interpreter {
                     }
                 }
 
-                function_context.add_symbol(symbol->name, Data(object));
+                function_context.add_symbol(*symbol, GC::new_reference(Data(object)));
+                return true;
             } else {
                 auto r = execute(function_context, p_function->function).to_data(context, parameters);
 
@@ -193,74 +313,111 @@ namespace Interpreter {
                     args = arguments;
                 }
 
-                auto const result = try_call_function(context, p_function, r, args);
-                if (auto const* reference = std::get_if<Reference>(&result)) {
-                    set_arguments(context, function_context, computed, p_function->arguments, *reference);
-                } else
-                    throw Interpreter::FunctionArgumentsError();
+                auto const callee = get_callee(context, p_function, r);
+                if (!callee)
+                    return false;
+
+                auto const result = call_overloads(context, p_function, callee, args);
+                return result && set_arguments(context, function_context, computed, p_function->arguments, *result);
             }
         } else if (auto p_property = std::dynamic_pointer_cast<Parser::Property>(parameters)) {
             auto reference = computed.compute(context, arguments);
 
             if (auto* property_reference = std::get_if<PropertyReference>(&reference)) {
-                if (p_property->name == property_reference->name || p_property->name == ".") {
-                    set_arguments(context, function_context, computed, p_property->object, Reference(property_reference->parent));
-                } else
-                    throw Interpreter::FunctionArgumentsError();
+                if (p_property->name == property_reference->name || p_property->name == ".")
+                    return set_arguments(context, function_context, computed, p_property->object, Reference(property_reference->parent));
+                else
+                    return false;
             } else
-                throw Interpreter::FunctionArgumentsError();
+                return false;
         } else
-            throw Interpreter::FunctionArgumentsError();
+            return false;
     }
 
-    std::variant<Reference, Exception> try_call_function(Context& context, std::shared_ptr<Parser::Expression> const& caller, Reference const& func, Arguments const& arguments) {
-        if (context.get_recurion_level() >= context.get_global().recursion_limit)
-            throw Exception(context, caller, "recursion limit exceeded");
-
-        std::list<Function> functions;
-        try {
-            functions = func.to_data(context, caller).get<ObjectPtr>()->functions;
-        } catch (Data::BadAccess const&) {}
-
-        if (functions.empty()) {
-            try {
-                functions = call_function(context, caller, context.get_global()["function_getter"], func).to_data(context).get<ObjectPtr>()->functions;
-            } catch (Data::BadAccess const&) {}
-        }
-
-        Computed computed;
-
-        for (auto const& function : functions) {
-            try {
-                FunctionContext function_context(context, caller);
+    namespace {
+
+        /**
+         * Calls the first overload of a function which accepts the arguments.
+         * The overloads are the ones present when the call starts, the overloads added or removed while trying the others are ignored.
+         * @param context the context of the call.
+         * @param caller the caller expression.
+         * @param callee the object holding the overloads.
+         * @param arguments the arguments.
+         * @return the result of the overload, or nothing if no overload accepted the arguments.
+        */
+        std::optional<Reference> call_overloads(Context& context, std::shared_ptr<Parser::Expression> const& caller, ObjectPtr const& callee, Arguments const& arguments) {
+            if (context.get_recurion_level() >= context.get_global().recursion_limit)
+                throw Exception(context, caller, "recursion limit exceeded");
+
+            // The dispatch cache can only be used when the arguments are the expression of the call
+            auto const* function_call = dynamic_cast<Parser::FunctionCall const*>(caller.get());
+            if (auto const* expression = std::get_if<ParserExpression>(&arguments); function_call && (!expression || *expression != function_call->arguments))
+                function_call = nullptr;
+
+            // The copy of the overloads is held until the call returns, so that it stays valid if the callee changes
+            auto const functions = callee->functions.get_snapshot();
+            auto const [cache, entry] = get_overloads(function_call, callee, *functions);
+
+            Computed computed;
+
+            for (auto const i : entry->candidates) {
+                auto const& function = (*functions)[i];
+                Counters::increment(Counters::Counter::OverloadsTried);
+
+                auto const* custom_function = std::get_if<CustomFunction>(&function);
+                FunctionContext function_context(context, caller, custom_function ? (*custom_function)->function_scope : nullptr);
+                for (auto const& [slot, reference] : function.captures)
+                    function_context.bind_slot(slot, reference);
                 for (auto const& symbol : function.extern_symbols)
                     function_context.add_symbol(symbol.first, symbol.second);
 
-                if (auto const* custom_function = std::get_if<CustomFunction>(&function)) {
-                    set_arguments(context, function_context, computed, (*custom_function)->parameters, arguments);
+                if (custom_function) {
+                    if (!set_arguments(context, function_context, computed, (*custom_function)->parameters, arguments))
+                        continue;
 
-                    Data filter = Data(true);
-                    if ((*custom_function)->filter != nullptr)
-                        filter = execute(function_context, (*custom_function)->filter).to_data(context, (*custom_function)->filter);
-
-                    try {
-                        if (filter.get<bool>())
-                            return Interpreter::execute(function_context, (*custom_function)->body);
-                        else
+                    if ((*custom_function)->filter != nullptr) {
+                        auto const filter = execute(function_context, (*custom_function)->filter).to_data(context, (*custom_function)->filter);
+                        if (auto const* b = get_if<bool>(&filter); !b || !*b)
                             continue;
-                    } catch (Data::BadAccess const&) {
-                        throw FunctionArgumentsError();
                     }
+
+                    Counters::increment(Counters::Counter::OverloadsMatched);
+                    Counters::increment(Counters::Counter::CustomCalls);
+                    return Interpreter::execute(function_context, (*custom_function)->body);
                 } else if (auto const* system_function = std::get_if<SystemFunction>(&function)) {
-                    set_arguments(context, function_context, computed, system_function->parameters, arguments);
+                    if (!set_arguments(context, function_context, computed, system_function->parameters, arguments))
+                        continue;
 
-                    return system_function->pointer(function_context);
+                    if (auto result = system_function->pointer(function_context)) {
+                        Counters::increment(Counters::Counter::OverloadsMatched);
+                        Counters::increment(Counters::Counter::SystemCalls);
+                        return result;
+                    }
                 } else
                     return Reference();
-            } catch (FunctionArgumentsError&) {}
+            }
+
+            return std::nullopt;
         }
 
-        if (functions.empty())
+    }
+
+    std::variant<Reference, Exception> try_call_function(Context& context, std::shared_ptr<Parser::Expression> const& caller, Reference const& func, Arguments const& arguments) {
+        if (context.get_recurion_level() >= context.get_global().recursion_limit)
+            throw Exception(context, caller, "recursion limit exceeded");
+
+        Profiler::sample(context, caller);
+
+        auto const callee = get_callee(context, caller, func);
+        if (!callee)
+            return Exception(context, caller, "not a function");
+
+        if (auto result = call_overloads(context, caller, callee, arguments)) {
+            // The time spent in the call is sampled before returning, for the functions which call nothing
+            Profiler::sample(context, caller);
+            return std::move(*result);
+        }
+        else if (callee->functions.empty())
             return Exception(context, caller, "not a function");
         else
             return Exception(context, caller, "incorrect function arguments");
@@ -275,47 +432,64 @@ namespace Interpreter {
             throw std::move(std::get<Exception>(r));
     }
 
+    namespace {
+
+        Reference walk(Context& context, std::shared_ptr<Parser::Expression> const& expression) {
+            if (auto function_call = std::dynamic_pointer_cast<Parser::FunctionCall>(expression)) {
+                auto reference = walk(context, function_call->function);
+
+                return call_function(context, function_call, reference, function_call->arguments);
+            } else if (auto function_definition = std::dynamic_pointer_cast<Parser::FunctionDefinition>(expression)) {
+                auto object = GC::new_object();
+                object->functions.emplace_front(CustomFunction{ function_definition });
+                auto& f = object->functions.back();
+
+                auto slot = function_definition->capture_slots.begin();
+                for (auto const& symbol : function_definition->captures)
+                    f.captures.emplace_back(*slot++, context[symbol]);
+
+                return Data(object);
+            } else if (auto property = std::dynamic_pointer_cast<Parser::Property>(expression)) {
+                auto data = walk(context, property->object).to_data(context, expression);
+                return data.get_property(*property);
+            } else if (auto literal = std::dynamic_pointer_cast<Parser::Literal>(expression)) {
+                if (auto const* b = std::get_if<bool>(&literal->value))
+                    return Data(*b);
+                else if (auto const* l = std::get_if<OV_INT>(&literal->value))
+                    return Data(*l);
+                else if (auto const* d = std::get_if<OV_FLOAT>(&literal->value))
+                    return Data(*d);
+                else
+                    return Data(GC::new_object(std::get<std::string>(literal->value)));
+            } else if (auto symbol = std::dynamic_pointer_cast<Parser::Symbol>(expression)) {
+                return context[*symbol];
+            } else if (auto tuple = std::dynamic_pointer_cast<Parser::Tuple>(expression)) {
+                TupleReference tuple_reference;
+                for (auto const& e : tuple->objects)
+                    tuple_reference.push_back(walk(context, e));
+                return tuple_reference;
+            } else
+                return {};
+        }
+
+    }
+
     Reference execute(Context& context, std::shared_ptr<Parser::Expression> const& expression) {
-        if (auto function_call = std::dynamic_pointer_cast<Parser::FunctionCall>(expression)) {
-            auto reference = execute(context, function_call->function);
-
-            return call_function(context, function_call, reference, function_call->arguments);
-        } else if (auto function_definition = std::dynamic_pointer_cast<Parser::FunctionDefinition>(expression)) {
-            auto object = GC::new_object();
-            object->functions.emplace_front(CustomFunction{ function_definition });
-            auto& f = object->functions.back();
-
-            for (auto symbol : function_definition->captures)
-                f.extern_symbols.emplace(symbol, context[symbol]);
-
-            return Data(object);
-        } else if (auto property = std::dynamic_pointer_cast<Parser::Property>(expression)) {
-            auto data = execute(context, property->object).to_data(context, expression);
-            return data.get_property(property->name);
-        } else if (auto symbol = std::dynamic_pointer_cast<Parser::Symbol>(expression)) {
-            auto data = get_symbol(symbol->name);
-            if (auto* b = std::get_if<bool>(&data)) {
-                return Data(*b);
-            } else if (auto* l = std::get_if<OV_INT>(&data)) {
-                return Data(*l);
-            } else if (auto* d = std::get_if<OV_FLOAT>(&data)) {
-                return Data(*d);
-            } else if (auto* str = std::get_if<std::string>(&data)) {
-                return Data(GC::new_object(*str));
-            } else {
-                return context[symbol->name];
-            }
-        } else if (auto tuple = std::dynamic_pointer_cast<Parser::Tuple>(expression)) {
-            TupleReference tuple_reference;
-            for (auto const& e : tuple->objects)
-                tuple_reference.push_back(execute(context, e));
-            return tuple_reference;
-        } else
-            return {};
+        if (context.get_global().engine == Engine::VirtualMachine)
+            return VirtualMachine::execute(context, expression);
+        else
+            return walk(context, expression);
     }
 
 
     Reference set(Context& context, Reference const& var, Reference const& data) {
+        if (context.get_global().setter.is_intact() && !std::holds_alternative<Data>(var) && !std::holds_alternative<TupleReference>(var)) {
+            // The data is computed first as a getter may move the properties
+            var.write(data.to_data(context));
+            return var;
+        }
+
+        Counters::increment(Counters::Counter::Setters);
         return call_function(context, nullptr, context.get_global()["setter"], TupleReference{ var, data });
     }
 
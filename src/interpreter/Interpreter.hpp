@@ -6,12 +6,14 @@
 #include <variant>
 #include <vector>
 
+#include "Array.hpp" // IWYU pragma: export
 #include "Context.hpp" // IWYU pragma: export
 #include "Data.hpp" // IWYU pragma: export
 #include "Function.hpp" // IWYU pragma: export
 #include "GC.hpp" // IWYU pragma: export
 #include "Object.hpp" // IWYU pragma: export
 #include "Reference.hpp" // IWYU pragma: export
+#include "Shape.hpp" // IWYU pragma: export
 
 #include "../parser/Expressions.hpp"
 
@@ -31,7 +33,6 @@ namespace Interpreter {
         void print_stack_trace(Context& context) const;
 
     };
-    class FunctionArgumentsError {};
 
     using Arguments = std::variant<std::shared_ptr<Parser::Expression>, Reference>;
 
@@ -40,6 +41,13 @@ namespace Interpreter {
 
     Reference execute(Context& context, std::shared_ptr<Parser::Expression> const& expression);
 
+    /**
+     * Starts parsing the files imported by a tree with a string literal in the background, before they are executed.
+     * @param context the global context which will import the files.
+     * @param expression the tree.
+    */
+    void prefetch_imports(GlobalContext& context, std::shared_ptr<Parser::Expression> const& expression);
+
     Reference set(Context& context, Reference const& var, Reference const& data);
     [[nodiscard]] std::string string_from(Context& context, Reference const& data);
 
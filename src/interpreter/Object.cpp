@@ -5,19 +5,18 @@
 
 namespace Interpreter {
 
-    Object::Object(std::string const& str) {
-        array.reserve(str.size());
-
-        for (auto c : str)
-            array.emplace_back(c);
-    }
+    Object::Object(std::string const& str) :
+        array(str) {}
 
     std::string Object::to_string() const {
+        if (auto const* str = array.get_string())
+            return *str;
+
         std::string str;
         str.reserve(array.size() + 1);
 
-        for (auto const& d : array)
-            str.push_back(d.get<char>());
+        for (size_t i = 0; i < array.size(); ++i)
+            str.push_back(array.get(i).get<char>());
 
         return str;
     }
@@ -6,13 +6,13 @@
 #include <any>
 #include <functional>
 #include <list>
-#include <map>
 #include <memory>
 #include <string>
-#include <vector>
 
+#include "Array.hpp"
 #include "Data.hpp"
 #include "Function.hpp"
+#include "Shape.hpp"
 
 namespace Interpreter {
 
@@ -36,6 +36,25 @@ namespace Interpreter {
             return object.has_value();
         }
 
+        template<typename T>
+        T* get_if() {
+            if (auto* t = std::any_cast<std::reference_wrapper<T>>(&object))
+                return &t->get();
+            else if (auto* t = std::any_cast<std::shared_ptr<T>>(&object))
+                return t->get();
+            else
+                return nullptr;
+        }
+        template<typename T>
+        T const* get_if() const {
+            if (auto const* t = std::any_cast<std::reference_wrapper<T>>(&object))
+                return &t->get();
+            else if (auto const* t = std::any_cast<std::shared_ptr<T>>(&object))
+                return t->get();
+            else
+                return nullptr;
+        }
+
         template<typename T>
         T& get() {
             if (auto* t = std::any_cast<std::reference_wrapper<T>>(&object))
@@ -49,9 +68,9 @@ namespace Interpreter {
 
     struct Object {
 
-        std::map<std::string, Data> properties;
-        std::list<Function> functions;
-        std::vector<Data> array;
+        Properties properties;
+        FunctionList functions;
+        Array array;
         CObj c_obj;
 
         Object() = default;
@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Profiler.hpp"
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter {
+
+    namespace {
+
+        /**
+         * Protects the running profiler and its samples.
+        */
+        std::mutex samples_mutex;
+        Profiler* running = nullptr;
+
+        /**
+         * Gets the name of the function called by an expression.
+         * @param expression the expression.
+         * @return the name, without the semicolons which separate the frames.
+        */
+        std::string get_name(Parser::Expression const& expression) {
+            std::string name;
+            if (auto const* function_call = dynamic_cast<Parser::FunctionCall const*>(&expression))
+                return function_call->function ? get_name(*function_call->function) : "(anonymous)";
+            else if (auto const* property = dynamic_cast<Parser::Property const*>(&expression))
+                name = property->name;
+            else if (auto const* symbol = dynamic_cast<Parser::Symbol const*>(&expression); symbol && dynamic_cast<Parser::Literal const*>(symbol) == nullptr)
+                name = symbol->name;
+            else
+                name = "(anonymous)";
+
+            std::replace(name.begin(), name.end(), ';', ':');
+            return name;
+        }
+
+        std::string get_frame(Parser::Expression const& expression) {
+            auto const& position = expression.position;
+            auto frame = get_name(expression);
+            if (position.file != 0) {
+                auto path = position.get_path();
+                std::replace(path.begin(), path.end(), ';', ':');
+                frame += " (" + path + ":" + std::to_string(position.line) + ")";
+            }
+            return frame;
+        }
+
+    }
+
+    Profiler::Profiler(std::chrono::microseconds interval) :
+        interval(interval) {
+        {
+            std::lock_guard lock(samples_mutex);
+            running = this;
+        }
+
+        timer = std::thread([this]() {
+            std::unique_lock lock(mutex);
+            while (!condition.wait_for(lock, this->interval, [this]() { return stopped; }))
+                requested.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    Profiler::~Profiler() {
+        {
+            std::lock_guard lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+        timer.join();
+
+        std::lock_guard lock(samples_mutex);
+        running = nullptr;
+        requested = 0;
+    }
+
+    void Profiler::record(Context& context, std::shared_ptr<Parser::Expression> const& caller) {
+        // The contexts are walked from the innermost one, as for the stack traces of the exceptions
+        std::vector<Parser::Expression const*> frames;
+        if (caller)
+            frames.push_back(caller.get());
+        Context* old_c = nullptr;
+        Context* c = &context;
+        while (c != old_c) {
+            if (auto* function_context = dynamic_cast<FunctionContext*>(c); (function_context != nullptr) && function_context->caller)
+                frames.push_back(function_context->caller.get());
+            old_c = c;
+            c = &c->get_parent();
+        }
+
+        std::string stack;
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            if (!stack.empty())
+                stack += ';';
+            stack += get_frame(**it);
+        }
+        if (stack.empty())
+            stack = "(global)";
+
+        std::lock_guard lock(samples_mutex);
+        auto const count = requested.exchange(0, std::memory_order_relaxed);
+        if (running != nullptr && count != 0)
+            running->samples[stack] += count;
+    }
+
+    void Profiler::write(std::ostream& os) {
+        std::lock_guard lock(samples_mutex);
+        for (auto const& [stack, count] : samples)
+            os << stack << ' ' << count << '\n';
+        os.flush();
+    }
+
+}
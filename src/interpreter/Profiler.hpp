@@ -0,0 +1,80 @@
+#ifndef __INTERPRETER_PROFILER_HPP__
+#define __INTERPRETER_PROFILER_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "Context.hpp"
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter {
+
+    /**
+     * Samples the stacks of the interpreter at a regular interval while it exists.
+     * A thread only requests the samples, the interpreter takes them at the next function call or return, so that the contexts are never read while they change.
+    */
+    class Profiler {
+
+        static inline std::atomic<unsigned> requested = 0;
+
+        std::chrono::microseconds interval;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopped = false;
+        std::thread timer;
+
+        /**
+         * The number of samples of each stack, as the frames from the outermost one separated by semicolons.
+        */
+        std::map<std::string, uint64_t> samples;
+
+        static void record(Context& context, std::shared_ptr<Parser::Expression> const& caller);
+
+    public:
+
+        /**
+         * Starts sampling, there can be only one profiler at a time.
+         * @param interval the interval between two samples.
+        */
+        explicit Profiler(std::chrono::microseconds interval = std::chrono::milliseconds(1));
+        Profiler(Profiler const&) = delete;
+        Profiler(Profiler&&) = delete;
+
+        Profiler& operator=(Profiler const&) = delete;
+        Profiler& operator=(Profiler&&) = delete;
+
+        ~Profiler();
+
+        /**
+         * Takes the requested samples, if any, with the stack of a function call.
+         * @param context the context of the call.
+         * @param caller the expression of the call.
+        */
+        static void sample(Context& context, std::shared_ptr<Parser::Expression> const& caller) {
+            if (requested.load(std::memory_order_relaxed) != 0)
+                record(context, caller);
+        }
+
+        /**
+         * Writes the samples in the folded format of the flame graph tools, a line "frame;frame;frame count" by stack.
+         * A frame is the name of the called function and the position of the call as "name (path:line)".
+         * @param os the output stream.
+        */
+        void write(std::ostream& os);
+
+    };
+
+}
+
+
+#endif
@@ -2,6 +2,7 @@
 #include <memory>
 #include <variant>
 
+#include "Counters.hpp"
 #include "Interpreter.hpp"
 
 #include "../parser/Expressions.hpp"
@@ -16,32 +17,59 @@ namespace Interpreter {
         template<class... Ts>
         overloaded(Ts...) -> overloaded<Ts...>;
 
+        Data* find_data(SymbolReference const& symbol_reference) {
+            return symbol_reference.get();
+        }
+
+        Data* find_data(PropertyReference const& property_reference) {
+            if (auto const* obj = get_if<ObjectPtr>(&property_reference.parent))
+                return &(*obj)->properties[property_reference];
+            else
+                return nullptr;
+        }
+
+        Data* find_data(ArrayReference const& array_reference) {
+            if (auto const* obj = get_if<ObjectPtr>(&array_reference.array))
+                if (array_reference.i < (*obj)->array.size())
+                    return &(*obj)->array[array_reference.i];
+            return nullptr;
+        }
+
+        Data read_data(ArrayReference const& array_reference) {
+            if (auto const* obj = get_if<ObjectPtr>(&array_reference.array))
+                if (array_reference.i < (*obj)->array.size())
+                    return (*obj)->array.get(array_reference.i);
+            return Data{};
+        }
+
+        void write_data(ArrayReference const& array_reference, Data const& data) {
+            if (auto const* obj = get_if<ObjectPtr>(&array_reference.array))
+                if (array_reference.i < (*obj)->array.size())
+                    (*obj)->array.set(array_reference.i, data);
+        }
+
         Data compute(Context& context, std::shared_ptr<Parser::Expression> const& caller, Reference const& reference) {
+            if (auto const* d = std::get_if<Data>(&reference); d && *d != Data{})
+                return *d;
+
+            auto& global = context.get_global();
+            if (global.getter.is_intact())
+                if (auto data = reference.read(); data != Data{})
+                    return data;
+
             if (auto const* symbol = std::get_if<SymbolReference>(&reference))
-                if (*symbol == std::get<SymbolReference>(context.get_global()["getter"]))
+                if (*symbol == std::get<SymbolReference>(global["getter"]))
                     return **symbol;
 
-            if (auto const* d = std::get_if<Data>(&reference); d && *d != Data{})
-                return *d;
-            else
-                return call_function(context, caller, context.get_global()["getter"], reference).to_data(context, caller);
+            Counters::increment(Counters::Counter::Getters);
+            return call_function(context, caller, global["getter"], reference).to_data(context, caller);
         }
 
     }
 
     Data& IndirectReference::get_data() const {
-        if (auto const* symbol_reference = std::get_if<SymbolReference>(this)) {
-            return **symbol_reference;
-        } else if (auto const* property_reference = std::get_if<PropertyReference>(this)) {
-            auto parent = property_reference->parent;
-            if (auto const* obj = get_if<ObjectPtr>(&parent))
-                return (*obj)->properties[property_reference->name];
-        } else if (auto const* array_reference = std::get_if<ArrayReference>(this)) {
-            auto array = array_reference->array;
-            if (auto const* obj = get_if<ObjectPtr>(&array))
-                if (array_reference->i < (*obj)->array.size())
-                    return (*obj)->array[array_reference->i];
-        }
+        if (auto* data = std::visit([](auto const& reference) { return find_data(reference); }, *this))
+            return *data;
 
         static Data empty_data;
         return empty_data = Data{};
@@ -61,6 +89,42 @@ namespace Interpreter {
         return compute(context, caller, *this);
     }
 
+    Data Reference::read() const {
+        return std::visit(
+            overloaded{
+                [](Data const& /*data*/) {
+                    return Data{};
+                },
+                [](TupleReference const& /*tuple_reference*/) {
+                    return Data{};
+                },
+                [](ArrayReference const& array_reference) {
+                    return read_data(array_reference);
+                },
+                [](auto const& reference) {
+                    auto const* data = Interpreter::find_data(reference);
+                    return data ? *data : Data{};
+                }
+            }
+        , *this);
+    }
+
+    void Reference::write(Data const& data) const {
+        std::visit(
+            overloaded{
+                [](Data const& /*data*/) {},
+                [](TupleReference const& /*tuple_reference*/) {},
+                [&data](ArrayReference const& array_reference) {
+                    write_data(array_reference, data);
+                },
+                [&data](auto const& reference) {
+                    if (auto* target = Interpreter::find_data(reference))
+                        *target = data;
+                }
+            }
+        , *this);
+    }
+
     IndirectReference Reference::to_indirect_reference(Context& context, std::shared_ptr<Parser::Expression> const& caller) const {
         return std::visit(
             overloaded{
@@ -4,6 +4,7 @@
 // IWYU pragma: private; include "Interpreter.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <variant>
@@ -25,6 +26,12 @@ namespace Interpreter {
         Data parent;
         std::string name;
 
+        /**
+         * The id of the shape of the parent when the reference was made and the slot of the property in it, if it was found.
+        */
+        uint32_t shape_id = 0;
+        size_t slot = 0;
+
         friend bool operator==(PropertyReference const& a, PropertyReference const& b) {
             return a.parent == b.parent && a.name == b.name;
         }
@@ -59,6 +66,18 @@ namespace Interpreter {
         [[nodiscard]] Data to_data(Context& context, std::shared_ptr<Parser::Expression> const& caller = nullptr) const;
         [[nodiscard]] IndirectReference to_indirect_reference(Context& context, std::shared_ptr<Parser::Expression> const& caller = nullptr) const;
 
+        /**
+         * Reads the data held by a symbol, a property or an array reference, as the builtin getter does.
+         * @return the data, or an empty data if the reference does not hold a data or if its array index is out of range.
+        */
+        [[nodiscard]] Data read() const;
+
+        /**
+         * Writes the data held by a symbol, a property or an array reference, as the builtin setter does.
+         * @param data the new data, ignored if the reference does not hold a data or if its array index is out of range.
+        */
+        void write(Data const& data) const;
+
     };
 
 }
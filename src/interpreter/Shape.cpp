@@ -0,0 +1,140 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "Interpreter.hpp"
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter {
+
+    namespace {
+
+        std::mutex transitions_mutex;
+        std::atomic<uint32_t> next_id = 1;
+
+    }
+
+    Shape::Shape() :
+        id(next_id++) {}
+
+    Shape::Shape(std::map<std::string, size_t> slots) :
+        id(next_id++), slots(std::move(slots)) {}
+
+    Shape const& Shape::get_root() {
+        static Shape const root;
+        return root;
+    }
+
+    size_t Shape::get_slot(std::string const& name) const {
+        auto it = slots.find(name);
+        if (it != slots.end())
+            return it->second;
+        else
+            return slots.size();
+    }
+
+    Shape const* Shape::add(std::string const& name) const {
+        if (slots.size() >= max_properties)
+            return nullptr;
+
+        std::lock_guard lock(transitions_mutex);
+
+        auto it = transitions.find(name);
+        if (it != transitions.end())
+            return it->second.get();
+        if (transitions.size() >= max_transitions)
+            return nullptr;
+
+        auto new_slots = slots;
+        new_slots.emplace(name, new_slots.size());
+        auto const& transition = transitions[name] = std::unique_ptr<Shape>(new Shape(std::move(new_slots)));
+        return transition.get();
+    }
+
+    Properties::Properties(Properties const& properties) :
+        shape(properties.shape), values(properties.values) {
+        if (properties.dictionary) {
+            dictionary = std::unique_ptr<Shape>(new Shape(properties.dictionary->slots));
+            shape = dictionary.get();
+        }
+    }
+
+    Properties& Properties::operator=(Properties const& properties) {
+        if (this != &properties) {
+            auto copy = properties;
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    Data& Properties::operator[](std::string const& name) {
+        auto slot = shape->get_slot(name);
+        if (slot < values.size())
+            return values[slot];
+
+        if (!dictionary) {
+            if (auto const* next = shape->add(name)) {
+                shape = next;
+                return values.emplace_back();
+            }
+            dictionary = std::unique_ptr<Shape>(new Shape(shape->slots));
+            shape = dictionary.get();
+        }
+
+        // The slots of a dictionary shape are only added, so that the references and the inline caches made from it stay valid
+        dictionary->slots.emplace(name, dictionary->slots.size());
+        return values.emplace_back();
+    }
+
+    Data& Properties::operator[](PropertyReference const& reference) {
+        if (reference.shape_id == shape->get_id())
+            return values[reference.slot];
+        else
+            return operator[](reference.name);
+    }
+
+    size_t Properties::find_slot(Parser::Property const& property) const {
+        for (auto const& entry : property.cache) {
+            auto const e = entry.load(std::memory_order_relaxed);
+            if (e >> 32 == shape->get_id())
+                return static_cast<size_t>(e & 0xFFFFFFFF);
+        }
+
+        auto slot = shape->get_slot(property.name);
+        if (slot < shape->size()) {
+            // The first entry is replaced when the cache is full
+            auto* entry = &property.cache.front();
+            for (auto& e : property.cache)
+                if (e.load(std::memory_order_relaxed) == 0) {
+                    entry = &e;
+                    break;
+                }
+            entry->store(static_cast<uint64_t>(shape->get_id()) << 32 | slot, std::memory_order_relaxed);
+        }
+        return slot;
+    }
+
+    bool operator==(Properties const& a, Properties const& b) {
+        if (a.shape == b.shape)
+            return a.values == b.values;
+        if (a.shape->size() != b.shape->size())
+            return false;
+
+        auto it = b.begin();
+        for (auto const& [name, value] : a) {
+            auto const& [other_name, other_value] = *it;
+            if (name != other_name || value != other_value)
+                return false;
+            ++it;
+        }
+        return true;
+    }
+
+}
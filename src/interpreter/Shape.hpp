@@ -0,0 +1,190 @@
+#ifndef __INTERPRETER_SHAPE_HPP__
+#define __INTERPRETER_SHAPE_HPP__
+
+// IWYU pragma: private; include "Interpreter.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Data.hpp"
+#include "Reference.hpp"
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter {
+
+    /**
+     * The hidden class of an object, which gives the slot of each of its properties.
+     * The objects which got the same properties in the same order share their shape, the shared shapes are never freed.
+     * An object which gets too many properties, or whose shape has too many transitions, switches to a dictionary shape, which it owns alone and extends in place.
+    */
+    class Shape {
+
+        uint32_t id;
+        std::map<std::string, size_t> slots;
+        mutable std::map<std::string, std::unique_ptr<Shape>> transitions;
+
+        Shape();
+        Shape(std::map<std::string, size_t> slots);
+
+        friend class Properties;
+
+    public:
+
+        /**
+         * The maximum number of properties of a shared shape.
+        */
+        static constexpr size_t max_properties = 64;
+
+        /**
+         * The maximum number of transitions from a shared shape.
+        */
+        static constexpr size_t max_transitions = 64;
+
+        Shape(Shape const&) = delete;
+        Shape(Shape&&) = delete;
+
+        Shape& operator=(Shape const&) = delete;
+        Shape& operator=(Shape&&) = delete;
+
+        /**
+         * Gets the shape of the objects without properties.
+         * @return the root shape.
+        */
+        [[nodiscard]] static Shape const& get_root();
+
+        [[nodiscard]] uint32_t get_id() const {
+            return id;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return slots.size();
+        }
+
+        /**
+         * Gets the slot of a property.
+         * @param name the name of the property.
+         * @return the slot of the property, or the size of the shape if there is no such property.
+        */
+        [[nodiscard]] size_t get_slot(std::string const& name) const;
+
+        /**
+         * Gets the shared shape obtained by adding a property.
+         * @param name the name of the new property.
+         * @return the shape with the new property in the last slot, or null if this shape has too many properties or transitions.
+        */
+        [[nodiscard]] Shape const* add(std::string const& name) const;
+
+        /**
+         * Iterates over the names of the properties and their slot, in the order of the names.
+        */
+        [[nodiscard]] auto begin() const {
+            return slots.begin();
+        }
+        [[nodiscard]] auto end() const {
+            return slots.end();
+        }
+
+    };
+
+    /**
+     * The properties of an object, stored in the slots given by its shape.
+    */
+    class Properties {
+
+        Shape const* shape = &Shape::get_root();
+        /**
+         * The dictionary shape of the object, if it has one, which is then its shape.
+        */
+        std::unique_ptr<Shape> dictionary;
+        std::vector<Data> values;
+
+    public:
+
+        Properties() = default;
+        Properties(Properties const& properties);
+        Properties(Properties&&) noexcept = default;
+
+        Properties& operator=(Properties const& properties);
+        Properties& operator=(Properties&&) noexcept = default;
+
+        ~Properties() = default;
+
+        class Iterator {
+
+            std::map<std::string, size_t>::const_iterator it;
+            Data const* values;
+
+        public:
+
+            Iterator(std::map<std::string, size_t>::const_iterator it, Data const* values) :
+                it(it), values(values) {}
+
+            [[nodiscard]] std::pair<std::string const&, Data const&> operator*() const {
+                return { it->first, values[it->second] };
+            }
+
+            Iterator& operator++() {
+                ++it;
+                return *this;
+            }
+
+            [[nodiscard]] friend bool operator==(Iterator const& a, Iterator const& b) {
+                return a.it == b.it;
+            }
+
+        };
+
+        [[nodiscard]] Shape const& get_shape() const {
+            return *shape;
+        }
+
+        /**
+         * Gets the values of the properties, in the order of their slots.
+        */
+        [[nodiscard]] std::vector<Data> const& get_values() const {
+            return values;
+        }
+
+        /**
+         * Gets a property, adding it if it does not exist.
+         * @param name the name of the property.
+         * @return the data of the property.
+        */
+        Data& operator[](std::string const& name);
+
+        /**
+         * Gets the property of a reference, directly from its slot if the shape did not change since the reference was made.
+         * @param reference the property reference, whose parent is the object of these properties.
+         * @return the data of the property.
+        */
+        Data& operator[](PropertyReference const& reference);
+
+        /**
+         * Finds the slot of a property through the inline cache of a property expression, and fills the cache on a miss.
+         * @param property the property expression.
+         * @return the slot of the property, or the size of the shape if there is no such property.
+        */
+        [[nodiscard]] size_t find_slot(Parser::Property const& property) const;
+
+        [[nodiscard]] Iterator begin() const {
+            return { shape->begin(), values.data() };
+        }
+        [[nodiscard]] Iterator end() const {
+            return { shape->end(), values.data() };
+        }
+
+        friend bool operator==(Properties const& a, Properties const& b);
+
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,706 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "Snapshot.hpp"
+
+#include "../parser/Cache.hpp"
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter::SystemFunctions {
+
+    namespace HashMap {
+        bool is_table(Object const&);
+        void restore_table(Object&);
+    }
+    namespace TreeMap {
+        bool is_tree(Object const&);
+        void restore_tree(Object&);
+    }
+
+}
+
+namespace Interpreter::Snapshot {
+
+    namespace {
+
+        /**
+         * The version of the format of the snapshots, to increment each time the format or the heap change.
+        */
+        uint32_t const version = 2;
+
+        std::string_view const magic = "OVSS";
+
+        /**
+         * Checks that the snapshot was written on a machine with the same byte order.
+        */
+        uint32_t const byte_order = 0x01020304;
+
+        enum class ReferenceTag : uint8_t {
+            Symbol,
+            Property,
+            Array
+        };
+
+        enum class FunctionTag : uint8_t {
+            Base,
+            Custom,
+            System
+        };
+
+        enum class ArrayTag : uint8_t {
+            Chars,
+            Data,
+            Floats,
+            Ints
+        };
+
+        /**
+         * The native values which can be saved, as the index of a map, which is made again from the entries in the array of its object.
+        */
+        enum class NativeTag : uint8_t {
+            None,
+            HashMap,
+            TreeMap
+        };
+
+        NativeTag get_native_tag(Object const& object) {
+            if (!object.c_obj.has_value())
+                return NativeTag::None;
+            else if (SystemFunctions::HashMap::is_table(object))
+                return NativeTag::HashMap;
+            else if (SystemFunctions::TreeMap::is_tree(object))
+                return NativeTag::TreeMap;
+            else
+                throw Exception("an object holding a native value other than the index of a map can not be saved in a snapshot.");
+        }
+
+        /**
+         * The objects and the references reachable from the global symbols and from the system object.
+         * They are walked breadth first, in the order of the symbols, of the slots, of the functions and of the elements, so that two contexts initialized the same way are walked the same way.
+        */
+        struct Heap {
+
+            std::vector<ObjectPtr> objects;
+            std::vector<SymbolReference> references;
+
+            std::unordered_map<Object const*, uint32_t> object_ids;
+            std::unordered_map<Data const*, uint32_t> reference_ids;
+
+            void add(Data const& data) {
+                if (auto const* object = get_if<ObjectPtr>(&data))
+                    if (object_ids.emplace(object->get(), static_cast<uint32_t>(objects.size())).second)
+                        objects.push_back(*object);
+            }
+
+            void add(IndirectReference const& reference) {
+                if (auto const* symbol = std::get_if<SymbolReference>(&reference)) {
+                    if (reference_ids.emplace(symbol->get(), static_cast<uint32_t>(references.size())).second)
+                        references.push_back(*symbol);
+                } else if (auto const* property = std::get_if<PropertyReference>(&reference)) {
+                    add(property->parent);
+                } else {
+                    add(std::get<ArrayReference>(reference).array);
+                }
+            }
+
+            explicit Heap(GlobalContext& context) {
+                for (auto const& symbol : context.get_symbols())
+                    add(context[symbol]);
+                add(context.system);
+
+                size_t o = 0;
+                size_t r = 0;
+                while (o < objects.size() || r < references.size()) {
+                    for (; o < objects.size(); ++o) {
+                        auto const& object = *objects[o];
+                        for (auto const& value : object.properties.get_values())
+                            add(value);
+                        for (auto const& function : object.functions) {
+                            for (auto const& [symbol, reference] : function.extern_symbols)
+                                add(reference);
+                            for (auto const& [slot, reference] : function.captures)
+                                add(reference);
+                        }
+                        if (auto const* vector = object.array.get_vector())
+                            for (auto const& element : *vector)
+                                add(element);
+                    }
+                    for (; r < references.size(); ++r)
+                        add(*references[r]);
+                }
+            }
+
+        };
+
+        class Writer {
+
+            GlobalContext& context;
+            Base const& base;
+            Heap heap;
+
+            std::string buffer;
+
+            std::unordered_map<Object const*, uint32_t> object_ids;
+            std::unordered_map<Data const*, uint32_t> reference_ids;
+            std::unordered_map<Function const*, uint32_t> function_ids;
+            /**
+             * The native values of the new objects, the ones of the base are made again by the initialization.
+            */
+            std::unordered_map<Object const*, NativeTag> native_tags;
+            uint32_t new_objects = 0;
+            uint32_t new_references = 0;
+
+            /**
+             * The roots of the trees and the position of the function definitions in them.
+            */
+            std::vector<std::shared_ptr<Parser::Expression>> trees;
+            std::unordered_map<Parser::Expression const*, uint32_t> tree_ids;
+            std::unordered_map<Parser::Expression const*, std::pair<uint32_t, uint32_t>> definitions;
+
+            template<typename T>
+            void write(T const& value) {
+                buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+            }
+
+            void write_string(std::string_view str) {
+                write(static_cast<uint32_t>(str.size()));
+                buffer.append(str);
+            }
+
+            void write_data(Data const& data) {
+                write(data.get_type());
+                switch (data.get_type()) {
+                case Data::Type::Object:
+                    write(object_ids.at(data.get<ObjectPtr>().get()));
+                    break;
+                case Data::Type::Char:
+                    write(data.get<char>());
+                    break;
+                case Data::Type::Float:
+                    write(data.get<OV_FLOAT>());
+                    break;
+                case Data::Type::Int:
+                    write(data.get<OV_INT>());
+                    break;
+                case Data::Type::Bool:
+                    write(static_cast<uint8_t>(data.get<bool>()));
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            void write_reference(IndirectReference const& reference) {
+                if (auto const* symbol = std::get_if<SymbolReference>(&reference)) {
+                    write(ReferenceTag::Symbol);
+                    write(reference_ids.at(symbol->get()));
+                } else if (auto const* property = std::get_if<PropertyReference>(&reference)) {
+                    write(ReferenceTag::Property);
+                    write_data(property->parent);
+                    write_string(property->name);
+                } else {
+                    auto const& array = std::get<ArrayReference>(reference);
+                    write(ReferenceTag::Array);
+                    write_data(array.array);
+                    write(static_cast<uint64_t>(array.i));
+                }
+            }
+
+            void write_function(Function const& function) {
+                if (auto it = function_ids.find(&function); it != function_ids.end()) {
+                    write(FunctionTag::Base);
+                    write(it->second);
+                    return;
+                }
+
+                if (auto const* custom = std::get_if<CustomFunction>(&function)) {
+                    auto const [tree, node] = definitions.at(custom->get());
+                    write(FunctionTag::Custom);
+                    write(tree);
+                    write(node);
+                } else {
+                    auto const& system_functions = base.system_functions;
+                    auto it = std::find(system_functions.begin(), system_functions.end(), std::get<SystemFunction>(function));
+                    if (it == system_functions.end())
+                        throw Exception("a system function made after the initialization can not be saved in a snapshot.");
+                    write(FunctionTag::System);
+                    write(static_cast<uint32_t>(it - system_functions.begin()));
+                }
+
+                write(static_cast<uint32_t>(function.extern_symbols.size()));
+                for (auto const& [symbol, reference] : function.extern_symbols) {
+                    write_string(symbol);
+                    write_reference(reference);
+                }
+                write(static_cast<uint32_t>(function.captures.size()));
+                for (auto const& [slot, reference] : function.captures) {
+                    write(static_cast<uint64_t>(slot));
+                    write_reference(reference);
+                }
+            }
+
+            void write_array(Array const& array) {
+                if (auto const* vector = array.get_vector()) {
+                    write(ArrayTag::Data);
+                    write(static_cast<uint64_t>(vector->capacity()));
+                    write(static_cast<uint64_t>(vector->size()));
+                    for (auto const& element : *vector)
+                        write_data(element);
+                } else if (auto const* floats = array.get_buffer<OV_FLOAT>()) {
+                    write(ArrayTag::Floats);
+                    write(static_cast<uint64_t>(floats->capacity()));
+                    write(static_cast<uint64_t>(floats->size()));
+                    buffer.append(reinterpret_cast<char const*>(floats->data()), floats->size() * sizeof(OV_FLOAT));
+                } else if (auto const* ints = array.get_buffer<OV_INT>()) {
+                    write(ArrayTag::Ints);
+                    write(static_cast<uint64_t>(ints->capacity()));
+                    write(static_cast<uint64_t>(ints->size()));
+                    buffer.append(reinterpret_cast<char const*>(ints->data()), ints->size() * sizeof(OV_INT));
+                } else {
+                    // The bytes may be followed by the empty elements left by a resize
+                    std::string bytes;
+                    if (auto const* str = array.get_string())
+                        bytes = *str;
+                    else
+                        for (size_t i = 0; i < array.size() && array.get(i).is<char>(); ++i)
+                            bytes.push_back(array.get(i).get<char>());
+                    write(ArrayTag::Chars);
+                    write_string(bytes);
+                    write(static_cast<uint64_t>(array.size()));
+                    write(static_cast<uint64_t>(array.capacity()));
+                }
+            }
+
+            void write_object(Object const& object) {
+                std::vector<std::string const*> names(object.properties.get_values().size());
+                for (auto const& [name, slot] : object.properties.get_shape())
+                    names[slot] = &name;
+                write(static_cast<uint32_t>(names.size()));
+                for (size_t slot = 0; slot < names.size(); ++slot) {
+                    write_string(*names[slot]);
+                    write_data(object.properties.get_values()[slot]);
+                }
+
+                write(static_cast<uint32_t>(object.functions.size()));
+                for (auto const& function : object.functions)
+                    write_function(function);
+
+                write_array(object.array);
+                auto it = native_tags.find(&object);
+                write(it != native_tags.end() ? it->second : NativeTag::None);
+            }
+
+            void add_tree(std::shared_ptr<Parser::Expression> const& root) {
+                if (tree_ids.emplace(root.get(), static_cast<uint32_t>(trees.size())).second)
+                    trees.push_back(root);
+            }
+
+        public:
+
+            Writer(GlobalContext& context, Base const& base) :
+                context(context), base(base), heap(context) {
+                for (uint32_t i = 0; i < base.objects.size(); ++i)
+                    object_ids.emplace(base.objects[i].get(), i);
+                for (uint32_t i = 0; i < base.references.size(); ++i)
+                    reference_ids.emplace(base.references[i].get(), i);
+                for (uint32_t i = 0; i < base.functions.size(); ++i)
+                    function_ids.emplace(base.functions[i], i);
+
+                for (auto const& object : heap.objects)
+                    if (object_ids.emplace(object.get(), static_cast<uint32_t>(base.objects.size()) + new_objects).second) {
+                        ++new_objects;
+                        if (auto const tag = get_native_tag(*object); tag != NativeTag::None)
+                            native_tags.emplace(object.get(), tag);
+                    }
+                for (auto const& reference : heap.references)
+                    if (reference_ids.emplace(reference.get(), static_cast<uint32_t>(base.references.size()) + new_references).second)
+                        ++new_references;
+
+                for (auto const& [path, root] : context.sources)
+                    add_tree(root);
+                for (auto const& object : heap.objects)
+                    for (auto const& function : object->functions)
+                        if (auto const* custom = std::get_if<CustomFunction>(&function))
+                            add_tree((*custom)->get_root());
+            }
+
+            std::string serialize() {
+                buffer.append(magic);
+                write(version);
+                write(byte_order);
+                write(static_cast<uint8_t>(sizeof(OV_INT)));
+                write(static_cast<uint8_t>(sizeof(OV_FLOAT)));
+                write(static_cast<uint32_t>(base.objects.size()));
+                write(static_cast<uint32_t>(base.references.size()));
+                write(static_cast<uint32_t>(base.functions.size()));
+                write(static_cast<uint32_t>(base.system_functions.size()));
+                write(new_objects);
+                write(new_references);
+
+                write(static_cast<uint32_t>(trees.size()));
+                for (uint32_t tree = 0; tree < trees.size(); ++tree) {
+                    std::vector<std::shared_ptr<Parser::Expression>> nodes;
+                    write_string(trees[tree]->position.get_path());
+                    write_string(Parser::Cache::serialize(trees[tree], nodes));
+                    for (uint32_t node = 0; node < nodes.size(); ++node)
+                        definitions.emplace(nodes[node].get(), std::make_pair(tree, node));
+                }
+
+                write(static_cast<uint32_t>(context.sources.size()));
+                for (auto const& [path, root] : context.sources) {
+                    write_string(path.string());
+                    write(tree_ids.at(root.get()));
+                }
+
+                auto const symbols = context.get_symbols();
+                write(static_cast<uint32_t>(symbols.size()));
+                for (auto const& symbol : symbols) {
+                    write_string(symbol);
+                    write_reference(context[symbol]);
+                }
+
+                write(static_cast<uint32_t>(heap.references.size()));
+                for (auto const& reference : heap.references) {
+                    write(reference_ids.at(reference.get()));
+                    write_data(*reference);
+                }
+
+                write(static_cast<uint32_t>(heap.objects.size()));
+                for (auto const& object : heap.objects) {
+                    write(object_ids.at(object.get()));
+                    write_object(*object);
+                }
+
+                return std::move(buffer);
+            }
+
+        };
+
+        /**
+         * Reads a snapshot, throws a std::out_of_range if it is truncated or corrupted.
+        */
+        class Reader {
+
+            GlobalContext& context;
+            Base const& base;
+
+            std::string_view data;
+            size_t offset = 0;
+
+            std::vector<ObjectPtr> objects;
+            std::vector<SymbolReference> references;
+            std::vector<std::vector<std::shared_ptr<Parser::Expression>>> trees;
+
+            /**
+             * The hash maps, whose index is made once all the keys are read.
+            */
+            std::vector<ObjectPtr> hash_maps;
+
+            template<typename T>
+            T read() {
+                if (data.size() - offset < sizeof(T))
+                    throw std::out_of_range("truncated snapshot");
+                T value;
+                std::memcpy(&value, data.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
+            }
+
+            std::string_view read_bytes(size_t size) {
+                if (data.size() - offset < size)
+                    throw std::out_of_range("truncated snapshot");
+                auto bytes = data.substr(offset, size);
+                offset += size;
+                return bytes;
+            }
+
+            std::string read_string() {
+                return std::string(read_bytes(read<uint32_t>()));
+            }
+
+            /**
+             * Reads a number of elements, checked against the bytes left so that a corrupted number is not allocated.
+             * @param element_size the smallest number of bytes of an element.
+             * @return the number of elements.
+            */
+            template<typename T = uint32_t>
+            size_t read_count(size_t element_size) {
+                auto const count = static_cast<size_t>(read<T>());
+                if ((data.size() - offset) / element_size < count)
+                    throw std::out_of_range("truncated snapshot");
+                return count;
+            }
+
+            Data read_data() {
+                switch (read<Data::Type>()) {
+                case Data::Type::Empty:
+                    return {};
+                case Data::Type::Object:
+                    return Data(objects.at(read<uint32_t>()));
+                case Data::Type::Char:
+                    return Data(read<char>());
+                case Data::Type::Float:
+                    return Data(read<OV_FLOAT>());
+                case Data::Type::Int:
+                    return Data(read<OV_INT>());
+                case Data::Type::Bool:
+                    return Data(read<uint8_t>() != 0);
+                default:
+                    throw std::out_of_range("unknown data");
+                }
+            }
+
+            IndirectReference read_reference() {
+                switch (read<ReferenceTag>()) {
+                case ReferenceTag::Symbol:
+                    return references.at(read<uint32_t>());
+                case ReferenceTag::Property: {
+                    auto parent = read_data();
+                    return PropertyReference{ .parent = parent, .name = read_string() };
+                }
+                case ReferenceTag::Array: {
+                    auto array = read_data();
+                    return ArrayReference{ .array = array, .i = static_cast<size_t>(read<uint64_t>()) };
+                }
+                default:
+                    throw std::out_of_range("unknown reference");
+                }
+            }
+
+            template<typename T>
+            Array read_buffer() {
+                auto const capacity = static_cast<size_t>(read<uint64_t>());
+                auto const size = read_count<uint64_t>(sizeof(T));
+                auto const bytes = read_bytes(size * sizeof(T));
+
+                std::vector<T> buffer;
+                buffer.reserve(std::max(capacity, size));
+                buffer.resize(size);
+                std::memcpy(buffer.data(), bytes.data(), bytes.size());
+                return Array(std::move(buffer));
+            }
+
+            Array read_array() {
+                switch (read<ArrayTag>()) {
+                case ArrayTag::Chars: {
+                    Array array(read_bytes(read<uint32_t>()));
+                    auto const size = static_cast<size_t>(read<uint64_t>());
+                    array.reserve(static_cast<size_t>(read<uint64_t>()));
+                    if (size > array.size())
+                        array.resize(size);
+                    return array;
+                }
+                case ArrayTag::Data: {
+                    auto const capacity = static_cast<size_t>(read<uint64_t>());
+                    auto const size = read_count<uint64_t>(sizeof(Data::Type));
+
+                    std::vector<Data> vector;
+                    vector.reserve(std::max(capacity, size));
+                    for (size_t i = 0; i < size; ++i)
+                        vector.push_back(read_data());
+                    return Array(std::move(vector));
+                }
+                case ArrayTag::Floats:
+                    return read_buffer<OV_FLOAT>();
+                case ArrayTag::Ints:
+                    return read_buffer<OV_INT>();
+                default:
+                    throw std::out_of_range("unknown array");
+                }
+            }
+
+            void read_object(Object& object) {
+                Properties properties;
+                auto const property_count = read_count(sizeof(uint32_t));
+                for (size_t i = 0; i < property_count; ++i) {
+                    auto name = read_string();
+                    properties[name] = read_data();
+                }
+
+                // The functions of the system are moved back to the new list, so that the pointers to them stay valid
+                std::list<Function> previous;
+                object.functions.swap(previous);
+                auto const function_count = read_count(sizeof(FunctionTag));
+                for (size_t i = 0; i < function_count; ++i) {
+                    auto const tag = read<FunctionTag>();
+                    if (tag == FunctionTag::Base) {
+                        auto const* function = base.functions.at(read<uint32_t>());
+                        auto it = std::find_if(previous.begin(), previous.end(), [function](Function const& f) {
+                            return &f == function;
+                        });
+                        if (it == previous.end())
+                            throw std::out_of_range("unknown function");
+                        object.functions.splice_back(previous, it);
+                        continue;
+                    } else if (tag == FunctionTag::Custom) {
+                        auto const& nodes = trees.at(read<uint32_t>());
+                        auto definition = std::dynamic_pointer_cast<Parser::FunctionDefinition>(nodes.at(read<uint32_t>()));
+                        if (!definition)
+                            throw std::out_of_range("unknown function definition");
+                        object.functions.emplace_back(definition);
+                    } else if (tag == FunctionTag::System) {
+                        object.functions.emplace_back(base.system_functions.at(read<uint32_t>()));
+                    } else {
+                        throw std::out_of_range("unknown function");
+                    }
+
+                    auto& function = object.functions.back();
+                    auto const extern_count = read_count(sizeof(uint32_t));
+                    for (size_t j = 0; j < extern_count; ++j) {
+                        auto symbol = read_string();
+                        function.extern_symbols.emplace(std::move(symbol), read_reference());
+                    }
+                    auto const capture_count = read_count(sizeof(uint64_t));
+                    for (size_t j = 0; j < capture_count; ++j) {
+                        auto const slot = static_cast<size_t>(read<uint64_t>());
+                        function.captures.emplace_back(slot, read_reference());
+                    }
+                }
+
+                object.properties = std::move(properties);
+                object.array = read_array();
+            }
+
+            void read_native(ObjectPtr const& object) {
+                switch (read<NativeTag>()) {
+                case NativeTag::None:
+                    break;
+                case NativeTag::HashMap:
+                    hash_maps.push_back(object);
+                    break;
+                case NativeTag::TreeMap:
+                    SystemFunctions::TreeMap::restore_tree(*object);
+                    break;
+                default:
+                    throw std::out_of_range("unknown native value");
+                }
+            }
+
+        public:
+
+            Reader(GlobalContext& context, Base const& base, std::string_view data) :
+                context(context), base(base), data(data) {}
+
+            void deserialize() {
+                if (data.substr(0, magic.size()) != magic)
+                    throw Exception("the file is not a snapshot.");
+                offset = magic.size();
+                if (read<uint32_t>() != version || read<uint32_t>() != byte_order || read<uint8_t>() != sizeof(OV_INT) || read<uint8_t>() != sizeof(OV_FLOAT))
+                    throw Exception("the snapshot was made by another version of the interpreter.");
+                if (read<uint32_t>() != base.objects.size() || read<uint32_t>() != base.references.size() || read<uint32_t>() != base.functions.size() || read<uint32_t>() != base.system_functions.size())
+                    throw Exception("the snapshot was made with other system functions.");
+
+                objects = base.objects;
+                auto const object_count = read_count(sizeof(uint32_t));
+                for (size_t i = 0; i < object_count; ++i)
+                    objects.push_back(GC::new_object());
+                references = base.references;
+                auto const reference_count = read_count(sizeof(uint32_t));
+                for (size_t i = 0; i < reference_count; ++i)
+                    references.push_back(GC::new_reference());
+
+                auto const tree_count = read_count(sizeof(uint64_t));
+                trees.resize(tree_count);
+                for (auto& nodes : trees) {
+                    auto const path = read_string();
+                    auto const tree = read_bytes(read<uint32_t>());
+                    if (!Parser::Cache::deserialize(tree, path, nodes))
+                        throw std::out_of_range("empty tree");
+                }
+
+                auto const source_count = read_count(sizeof(uint64_t));
+                for (size_t i = 0; i < source_count; ++i) {
+                    std::filesystem::path path = read_string();
+                    context.sources[path] = trees.at(read<uint32_t>()).front();
+                }
+
+                auto const symbol_count = read_count(sizeof(uint32_t));
+                for (size_t i = 0; i < symbol_count; ++i) {
+                    auto const symbol = read_string();
+                    context.add_symbol(symbol, read_reference());
+                }
+
+                auto const reference_record_count = read_count(sizeof(uint32_t));
+                for (size_t i = 0; i < reference_record_count; ++i) {
+                    auto const& reference = references.at(read<uint32_t>());
+                    *reference = read_data();
+                }
+
+                auto const object_record_count = read_count(sizeof(uint32_t));
+                for (size_t i = 0; i < object_record_count; ++i) {
+                    auto const& object = objects.at(read<uint32_t>());
+                    read_object(*object);
+                    read_native(object);
+                }
+                for (auto const& object : hash_maps)
+                    SystemFunctions::HashMap::restore_table(*object);
+
+                if (offset != data.size())
+                    throw std::out_of_range("trailing bytes");
+            }
+
+        };
+
+    }
+
+    Base::Base(GlobalContext& context) {
+        Heap heap(context);
+        objects = std::move(heap.objects);
+        references = std::move(heap.references);
+
+        for (auto const& object : objects)
+            for (auto const& function : object->functions) {
+                functions.push_back(&function);
+                if (auto const* system_function = std::get_if<SystemFunction>(&function))
+                    if (std::find(system_functions.begin(), system_functions.end(), *system_function) == system_functions.end())
+                        system_functions.push_back(*system_function);
+            }
+    }
+
+    void save(GlobalContext& context, Base const& base, std::filesystem::path const& path) {
+        auto const data = Writer(context, base).serialize();
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file.write(data.data(), static_cast<std::streamsize>(data.size())))
+            throw Exception("unable to write the snapshot file \"" + path.string() + "\".");
+    }
+
+    void load(GlobalContext& context, Base const& base, std::filesystem::path const& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw Exception("unable to load the snapshot file \"" + path.string() + "\".");
+        std::string data(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size())))
+            throw Exception("unable to load the snapshot file \"" + path.string() + "\".");
+
+        // The capacities of the arrays are not read from the bytes, so a corrupted one is only known when it is allocated
+        try {
+            Reader(context, base, data).deserialize();
+        } catch (std::out_of_range const&) {
+            throw Exception("the snapshot file \"" + path.string() + "\" is corrupted.");
+        } catch (std::length_error const&) {
+            throw Exception("the snapshot file \"" + path.string() + "\" is corrupted.");
+        } catch (std::bad_alloc const&) {
+            throw Exception("the snapshot file \"" + path.string() + "\" is corrupted.");
+        }
+    }
+
+}
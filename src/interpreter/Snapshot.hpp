@@ -0,0 +1,69 @@
+#ifndef __INTERPRETER_SNAPSHOT_HPP__
+#define __INTERPRETER_SNAPSHOT_HPP__
+
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Interpreter.hpp"
+
+
+namespace Interpreter::Snapshot {
+
+    class Exception : public std::exception {
+
+        std::string message;
+
+    public:
+
+        explicit Exception(std::string message) :
+            message(std::move(message)) {}
+
+        [[nodiscard]] const char* what() const noexcept override {
+            return message.c_str();
+        }
+
+    };
+
+    /**
+     * The heap of a global context just after the initialization of the system functions, in the order it is walked.
+     * The system functions are always initialized the same way, so a snapshot only saves the index of the objects, of the references and of the functions they made.
+    */
+    struct Base {
+
+        std::vector<ObjectPtr> objects;
+        std::vector<SymbolReference> references;
+        std::vector<Function const*> functions;
+        std::vector<SystemFunction> system_functions;
+
+        /**
+         * Walks the heap of a global context, which must not have executed anything yet.
+         * @param context the global context.
+        */
+        explicit Base(GlobalContext& context);
+
+    };
+
+    /**
+     * Saves the global symbols, the heap they reach and the imported files of a global context, so that a new process can start from them instead of executing the files again.
+     * @param context the global context.
+     * @param base the heap of the context when it was created.
+     * @param path the path of the snapshot file.
+    */
+    void save(GlobalContext& context, Base const& base, std::filesystem::path const& path);
+
+    /**
+     * Loads a snapshot in a global context, which must not have executed anything yet.
+     * The imported files of the snapshot are not imported again.
+     * @param context the global context.
+     * @param base the heap of the context when it was created.
+     * @param path the path of the snapshot file.
+    */
+    void load(GlobalContext& context, Base const& base, std::filesystem::path const& path);
+
+}
+
+
+#endif
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "Interpreter.hpp"
+#include "VirtualMachine.hpp"
+
+#include "../compiler/Bytecode.hpp"
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter::VirtualMachine {
+
+    namespace {
+
+        /**
+         * The stack of the virtual machine, shared by the nested executions of a thread.
+        */
+        thread_local std::vector<Reference> stack;
+
+        class Frame {
+
+            size_t base;
+
+        public:
+
+            Frame() :
+                base(stack.size()) {}
+            Frame(Frame const&) = delete;
+            Frame(Frame&&) = delete;
+
+            Frame& operator=(Frame const&) = delete;
+            Frame& operator=(Frame&&) = delete;
+
+            ~Frame() {
+                stack.erase(stack.begin() + static_cast<std::ptrdiff_t>(base), stack.end());
+            }
+
+        };
+
+        Reference pop() {
+            auto reference = std::move(stack.back());
+            stack.pop_back();
+            return reference;
+        }
+
+        Data get_literal(Compiler::Literal const& literal) {
+            if (auto const* b = std::get_if<bool>(&literal))
+                return Data(*b);
+            else if (auto const* l = std::get_if<OV_INT>(&literal))
+                return Data(*l);
+            else
+                return Data(std::get<OV_FLOAT>(literal));
+        }
+
+    }
+
+    Reference execute(Context& context, std::shared_ptr<Parser::Expression> const& expression) {
+        auto const& bytecode = Compiler::get_bytecode(expression);
+        auto const get_expression = [&bytecode, &expression](uint32_t i) -> std::shared_ptr<Parser::Expression> const& {
+            return i == 0 ? expression : bytecode.expressions[i];
+        };
+
+        Frame frame;
+        // Grows the stack geometrically, an exact reservation would reallocate it at each nested execution
+        if (auto const size = stack.size() + bytecode.stack_size; size > stack.capacity())
+            stack.reserve(std::max(size, 2 * stack.capacity()));
+
+        for (auto const& instruction : bytecode.instructions) {
+            switch (instruction.code) {
+            case Compiler::OpCode::Constant:
+                stack.emplace_back(get_literal(bytecode.literals[instruction.operand]));
+                break;
+            case Compiler::OpCode::String:
+                stack.emplace_back(Data(GC::new_object(std::get<std::string>(bytecode.literals[instruction.operand]))));
+                break;
+            case Compiler::OpCode::Symbol: {
+                auto const& symbol = static_cast<Parser::Symbol const&>(*get_expression(instruction.operand));
+                stack.emplace_back(context[symbol]);
+                break;
+            }
+            case Compiler::OpCode::Property: {
+                auto const& property = get_expression(instruction.operand);
+                auto data = pop().to_data(context, property);
+                stack.emplace_back(data.get_property(static_cast<Parser::Property const&>(*property)));
+                break;
+            }
+            case Compiler::OpCode::Call: {
+                auto const& function_call = get_expression(instruction.operand);
+                auto function = pop();
+                stack.push_back(call_function(context, function_call, function, static_cast<Parser::FunctionCall const&>(*function_call).arguments));
+                break;
+            }
+            case Compiler::OpCode::Function: {
+                auto function_definition = std::static_pointer_cast<Parser::FunctionDefinition>(get_expression(instruction.operand));
+                auto object = GC::new_object();
+                object->functions.emplace_front(CustomFunction{ function_definition });
+                auto& f = object->functions.back();
+
+                auto slot = function_definition->capture_slots.begin();
+                for (auto const& symbol : function_definition->captures)
+                    f.captures.emplace_back(*slot++, context[symbol]);
+
+                stack.emplace_back(Data(object));
+                break;
+            }
+            case Compiler::OpCode::Tuple: {
+                auto const begin = stack.end() - static_cast<std::ptrdiff_t>(instruction.operand);
+                TupleReference tuple_reference(std::make_move_iterator(begin), std::make_move_iterator(stack.end()));
+                stack.erase(begin, stack.end());
+                stack.emplace_back(std::move(tuple_reference));
+                break;
+            }
+            }
+        }
+
+        return pop();
+    }
+
+}
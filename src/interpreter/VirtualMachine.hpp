@@ -0,0 +1,25 @@
+#ifndef __INTERPRETER_VIRTUALMACHINE_HPP__
+#define __INTERPRETER_VIRTUALMACHINE_HPP__
+
+#include <memory>
+
+#include "Context.hpp"
+#include "Reference.hpp"
+
+#include "../parser/Expressions.hpp"
+
+
+namespace Interpreter::VirtualMachine {
+
+    /**
+     * Executes an expression by running its bytecode in a dispatch loop.
+     * @param context the context of the execution.
+     * @param expression the expression to execute.
+     * @return the reference resulting of the expression.
+    */
+    Reference execute(Context& context, std::shared_ptr<Parser::Expression> const& expression);
+
+}
+
+
+#endif
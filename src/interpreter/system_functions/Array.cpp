@@ -1,7 +1,12 @@
 #include <algorithm>
 #include <cstddef>
 #include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <variant>
+#include <vector>
 
 #include <ouverium/types.h>
 
@@ -34,10 +39,10 @@ namespace Interpreter::SystemFunctions::Array {
         return Data();
     }
 
-    Reference get(ObjectPtr const& array, OV_INT i) {
+    std::optional<Reference> get(ObjectPtr const& array, OV_INT i) {
         if (i >= 0 && i < static_cast<OV_INT>(array->array.size()))
             return Data(array).get_at(static_cast<size_t>(i));
-        else throw FunctionArgumentsError();
+        else return std::nullopt;
     }
 
     auto const copy_data_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -49,27 +54,136 @@ namespace Interpreter::SystemFunctions::Array {
             std::make_shared<Parser::Symbol>("n")
         }
     ));
-    Reference copy_data(ObjectPtr const& from_array, OV_INT from_i, ObjectPtr const& to_array, OV_INT to_i, OV_INT n) {
+    std::optional<Reference> copy_data(ObjectPtr const& from_array, OV_INT from_i, ObjectPtr const& to_array, OV_INT to_i, OV_INT n) {
         if (n < 0)
-            throw FunctionArgumentsError();
+            return std::nullopt;
         else if (n == 0)
             return Data{};
         if (from_i < 0 || from_i + static_cast<size_t>(n) > from_array->array.size())
-            throw FunctionArgumentsError();
+            return std::nullopt;
         if (to_i < 0 || to_i + static_cast<size_t>(n) > to_array->array.size())
-            throw FunctionArgumentsError();
+            return std::nullopt;
 
-        if (from_i < to_i) {
-            for (OV_INT i = n - 1; i >= 0; --i)
-                to_array->array[to_i + i] = from_array->array[from_i + i];
-        } else {
-            for (OV_INT i = 0; i < n; ++i)
-                to_array->array[to_i + i] = from_array->array[from_i + i];
-        }
+        to_array->array.copy(from_array->array, from_i, to_i, n);
 
         return Data{};
     }
 
+    Reference is_string(ObjectPtr const& array) {
+        return Data(array->array.get_string() != nullptr);
+    }
+
+    Reference concat(ObjectPtr const& a, ObjectPtr const& b) {
+        auto object = GC::new_object();
+        auto size = a->array.size() + b->array.size();
+        object->array.reserve(std::max(static_cast<size_t>(1), size));
+        object->array.resize(size);
+        object->array.copy(a->array, 0, 0, a->array.size());
+        object->array.copy(b->array, 0, a->array.size(), b->array.size());
+
+        return Data(object);
+    }
+
+    Reference append(ObjectPtr const& array, ObjectPtr const& elements) {
+        auto size = array->array.size();
+        auto n = elements->array.size();
+        array->array.resize(size + n);
+        array->array.copy(elements->array, 0, size, n);
+
+        return Data(array);
+    }
+
+    Reference find(ObjectPtr const& array, ObjectPtr const& elements) {
+        if (auto const* str = array->array.get_string())
+            if (auto const* substr = elements->array.get_string()) {
+                auto i = str->find(*substr);
+                return Data(i != std::string::npos ? static_cast<OV_INT>(i) : static_cast<OV_INT>(-1));
+            }
+
+        auto n = elements->array.size();
+        for (size_t i = 0; i + n <= array->array.size(); ++i) {
+            size_t j = 0;
+            while (j < n && array->array.get(i + j) == elements->array.get(j))
+                ++j;
+            if (j == n)
+                return Data(static_cast<OV_INT>(i));
+        }
+        return Data(static_cast<OV_INT>(-1));
+    }
+
+    std::optional<Reference> slice(ObjectPtr const& array, OV_INT begin, OV_INT n) {
+        if (begin < 0 || n < 0 || begin + static_cast<size_t>(n) > array->array.size())
+            return std::nullopt;
+
+        auto object = GC::new_object();
+        object->array.reserve(std::max(static_cast<OV_INT>(1), n));
+        object->array.resize(n);
+        object->array.copy(array->array, begin, 0, n);
+
+        return Data(object);
+    }
+
+    template<typename T>
+    std::optional<Reference> typed_create(OV_INT size) {
+        if (size < 0)
+            return std::nullopt;
+
+        auto object = GC::new_object();
+        std::vector<T> buffer;
+        buffer.reserve(std::max(static_cast<OV_INT>(1), size));
+        buffer.resize(size);
+        object->array = Interpreter::Array(std::move(buffer));
+
+        return Data(object);
+    }
+
+    template<typename T>
+    std::optional<Reference> typed_from(ObjectPtr const& array) {
+        std::vector<T> buffer;
+        buffer.reserve(std::max(static_cast<size_t>(1), array->array.size()));
+        for (size_t i = 0; i < array->array.size(); ++i) {
+            auto element = array->array.get(i);
+            if (auto const* t = get_if<T>(&element))
+                buffer.push_back(*t);
+            else if (auto const* n = get_if<OV_INT>(&element); n && std::is_same_v<T, OV_FLOAT>)
+                buffer.push_back(static_cast<T>(*n));
+            else
+                return std::nullopt;
+        }
+
+        auto object = GC::new_object();
+        object->array = Interpreter::Array(std::move(buffer));
+
+        return Data(object);
+    }
+
+    template<typename T>
+    Reference is_typed(ObjectPtr const& array) {
+        return Data(array->array.get_buffer<T>() != nullptr);
+    }
+
+    Reference fill(ObjectPtr const& array, Data const& value) {
+        if (auto* floats = array->array.get_buffer<OV_FLOAT>(); floats && get_if<OV_FLOAT>(&value))
+            std::fill(floats->begin(), floats->end(), value.get<OV_FLOAT>());
+        else if (auto* ints = array->array.get_buffer<OV_INT>(); ints && get_if<OV_INT>(&value))
+            std::fill(ints->begin(), ints->end(), value.get<OV_INT>());
+        else
+            for (size_t i = 0; i < array->array.size(); ++i)
+                array->array.set(i, value);
+
+        return Data(array);
+    }
+
+    Reference boxed(ObjectPtr const& array) {
+        auto object = GC::new_object();
+        auto size = array->array.size();
+        object->array.reserve(std::max(static_cast<size_t>(1), size));
+        for (size_t i = 0; i < size; ++i)
+            object->array.push_back(array->array.get(i));
+
+        return Data(object);
+    }
+
     auto const foreach_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
         {
             std::make_shared<Parser::FunctionCall>(
@@ -79,56 +193,53 @@ namespace Interpreter::SystemFunctions::Array {
             std::make_shared<Parser::Symbol>("function")
         }
     ));
-    Reference foreach(FunctionContext& context) {
-        try {
-            auto array = Interpreter::call_function(context.get_parent(), nullptr, context["array"], std::make_shared<Parser::Tuple>());
-
-            if (auto* tuple = std::get_if<TupleReference>(&array)) {
-                for (auto const& r : *tuple)
-                    Interpreter::call_function(context.get_parent(), nullptr, context["function"], r);
-            } else {
-                auto obj = array.to_data(context).get<ObjectPtr>();
-                size_t size = obj->array.size();
-                for (size_t i = 0; i < size; ++i)
-                    Interpreter::call_function(context.get_parent(), nullptr, context["function"], Data(obj).get_at(i));
-            }
+    std::optional<Reference> foreach(FunctionContext& context) {
+        auto array = Interpreter::call_function(context.get_parent(), nullptr, context["array"], std::make_shared<Parser::Tuple>());
 
-            return Data{};
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+        if (auto* tuple = std::get_if<TupleReference>(&array)) {
+            for (auto const& r : *tuple)
+                Interpreter::call_function(context.get_parent(), nullptr, context["function"], r);
+        } else {
+            auto data = array.to_data(context);
+            auto const* obj = get_if<ObjectPtr>(&data);
+            if (!obj)
+                return std::nullopt;
+
+            size_t size = (*obj)->array.size();
+            for (size_t i = 0; i < size; ++i)
+                Interpreter::call_function(context.get_parent(), nullptr, context["function"], data.get_at(i));
         }
+
+        return Data{};
     }
 
     auto const function_extract_args = std::make_shared<Parser::Symbol>("function");
-    Reference function_extract(FunctionContext& context) {
-        try {
-            auto const& functions = context["function"].to_data(context).get<ObjectPtr>()->functions;
-
-            auto object = GC::new_object();
-            object->array.reserve(std::min(static_cast<size_t>(1), functions.size()));
-            for (auto const& f : functions) {
-                auto obj = GC::new_object();
-                obj->functions.push_front(f);
-                object->array.emplace_back(obj);
-            }
+    std::optional<Reference> function_extract(FunctionContext& context) {
+        auto const function = get_arg<ObjectPtr>(context, context["function"].to_data(context));
+        if (!function)
+            return std::nullopt;
 
-            return Data(object);
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+        auto const& functions = (*function)->functions;
+        auto object = GC::new_object();
+        object->array.reserve(std::min(static_cast<size_t>(1), functions.size()));
+        for (auto const& f : functions) {
+            auto obj = GC::new_object();
+            obj->functions.push_front(f);
+            object->array.push_back(Data(obj));
         }
+
+        return Data(object);
     }
 
     auto const function_clear_args = std::make_shared<Parser::Symbol>("function");
-    Reference function_clear(FunctionContext& context) {
-        try {
-            auto function = context["function"].to_data(context).get<ObjectPtr>();
+    std::optional<Reference> function_clear(FunctionContext& context) {
+        auto const function = get_arg<ObjectPtr>(context, context["function"].to_data(context));
+        if (!function)
+            return std::nullopt;
 
-            function->functions.clear();
+        (*function)->functions.clear();
 
-            return context["function"];
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        return context["function"];
     }
 
     void init(GlobalContext& context) {
@@ -139,6 +250,19 @@ namespace Interpreter::SystemFunctions::Array {
         add_function(Data(array).get_property("set_size"), set_size);
         add_function(Data(array).get_property("get"), get);
         add_function(Data(array).get_property("copy_data"), copy_data);
+        add_function(Data(array).get_property("is_string"), is_string);
+        add_function(Data(array).get_property("concat"), concat);
+        add_function(Data(array).get_property("append"), append);
+        add_function(Data(array).get_property("find"), find);
+        add_function(Data(array).get_property("slice"), slice);
+        add_function(Data(array).get_property("float_array"), typed_create<OV_FLOAT>);
+        add_function(Data(array).get_property("float_array"), typed_from<OV_FLOAT>);
+        add_function(Data(array).get_property("int_array"), typed_create<OV_INT>);
+        add_function(Data(array).get_property("int_array"), typed_from<OV_INT>);
+        add_function(Data(array).get_property("is_float_array"), is_typed<OV_FLOAT>);
+        add_function(Data(array).get_property("is_int_array"), is_typed<OV_INT>);
+        add_function(Data(array).get_property("fill"), fill);
+        add_function(Data(array).get_property("boxed"), boxed);
 
         add_function(context["foreach"], foreach_args, foreach);
 
@@ -3,6 +3,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <sstream>
 #include <string>
@@ -20,14 +21,14 @@
 namespace Interpreter::SystemFunctions::Base {
 
     auto const getter_args = std::make_shared<Parser::Symbol>("var");
-    Reference getter(FunctionContext& context) {
+    std::optional<Reference> getter(FunctionContext& context) {
         auto var = context["var"];
 
-        Data data = var.get_data();
+        Data data = Reference(var).read();
         if (data != Data{})
             return data;
         else
-            throw FunctionArgumentsError();
+            return std::nullopt;
     }
     auto const function_getter_args = std::make_shared<Parser::Symbol>("function");
     Reference function_getter(FunctionContext& context) {
@@ -37,30 +38,27 @@ namespace Interpreter::SystemFunctions::Base {
     Reference defined(FunctionContext& context) {
         auto var = context["var"];
 
-        return Data(var.get_data() != Data{});
+        return Data(Reference(var).read() != Data{});
     }
 
-    Reference assignation(Context& context, Reference const& var, Data const& d) {
+    std::optional<Reference> assignation(Context& context, Reference const& var, Data const& d) {
         if (std::get_if<Data>(&var)) return d;
         else if (auto const* symbol_reference = std::get_if<SymbolReference>(&var)) **symbol_reference = d;
         else if (auto const* property_reference = std::get_if<PropertyReference>(&var)) {
             auto parent = property_reference->parent;
             if (auto const* obj = get_if<ObjectPtr>(&parent))
-                (*obj)->properties[property_reference->name] = d;
+                (*obj)->properties[*property_reference] = d;
         } else if (auto const* array_reference = std::get_if<ArrayReference>(&var)) {
             auto array = array_reference->array;
             if (auto const* obj = get_if<ObjectPtr>(&array))
-                (*obj)->array[array_reference->i] = d;
+                (*obj)->array.set(array_reference->i, d);
         } else if (auto const* tuple_reference = std::get_if<TupleReference>(&var)) {
-            try {
-                auto const& object = d.get<ObjectPtr>();
-                if (tuple_reference->size() == object->array.size()) {
-                    for (size_t i = 0; i < tuple_reference->size(); ++i)
-                        assignation(context, (*tuple_reference)[i], object->array[i]);
-                } else throw Interpreter::FunctionArgumentsError();
-            } catch (Data::BadAccess const&) {
-                throw Interpreter::FunctionArgumentsError();
-            }
+            auto const* object = get_if<ObjectPtr>(&d);
+            if (object && tuple_reference->size() == (*object)->array.size()) {
+                for (size_t i = 0; i < tuple_reference->size(); ++i)
+                    if (!assignation(context, (*tuple_reference)[i], (*object)->array.get(i)))
+                        return std::nullopt;
+            } else return std::nullopt;
         }
         return var;
     }
@@ -74,7 +72,7 @@ namespace Interpreter::SystemFunctions::Base {
             std::make_shared<Parser::Symbol>("data")
         }
     ));
-    Reference setter(FunctionContext& context) {
+    std::optional<Reference> setter(FunctionContext& context) {
         auto var = Interpreter::call_function(context.get_parent(), nullptr, context["var"], std::make_shared<Parser::Tuple>());
         auto data = context["data"].to_data(context);
 
@@ -96,36 +94,43 @@ namespace Interpreter::SystemFunctions::Base {
         std::make_shared<Parser::Symbol>("function"),
         std::make_shared<Parser::Tuple>()
     );
-    Reference if_statement(FunctionContext& context) {
-        try {
-            auto function = std::get<CustomFunction>(context["function"].to_data(context).get<ObjectPtr>()->functions.front())->body;
-
-            if (auto tuple = std::dynamic_pointer_cast<Parser::Tuple>(function)) {
-                if (tuple->objects.size() >= 2) {
-                    auto& parent = context.get_parent();
-
-                    if (Interpreter::execute(parent, tuple->objects[0]).to_data(context).get<bool>())
-                        return Interpreter::execute(parent, tuple->objects[1]);
-                    else {
-                        size_t i = 2;
-                        while (i < tuple->objects.size()) {
-                            auto else_s = Interpreter::execute(parent, tuple->objects[i]);
-                            if (else_s.to_indirect_reference(context) == context["else"] && i + 1 < tuple->objects.size()) {
-                                auto s = Interpreter::execute(parent, tuple->objects[i + 1]);
-                                if (s.to_indirect_reference(context) == context["if"] && i + 3 < tuple->objects.size()) {
-                                    if (Interpreter::execute(parent, tuple->objects[i + 2]).to_data(context).get<bool>())
-                                        return Interpreter::execute(parent, tuple->objects[i + 3]);
-                                    else i += 4;
-                                } else return s;
-                            } else throw Interpreter::FunctionArgumentsError();
-                        }
-                        return {};
-                    }
-                } else throw Interpreter::FunctionArgumentsError();
-            } else throw Interpreter::FunctionArgumentsError();
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+    std::optional<Reference> if_statement(FunctionContext& context) {
+        auto object = get_arg<ObjectPtr>(context, context["function"].to_data(context));
+        if (!object)
+            return std::nullopt;
+        auto const* custom = std::get_if<CustomFunction>(&std::as_const((*object)->functions).front());
+        if (!custom)
+            return std::nullopt;
+
+        auto tuple = std::dynamic_pointer_cast<Parser::Tuple>((*custom)->body);
+        if (!tuple || tuple->objects.size() < 2)
+            return std::nullopt;
+
+        auto& parent = context.get_parent();
+
+        auto condition = get_arg<bool>(context, Interpreter::execute(parent, tuple->objects[0]).to_data(context));
+        if (!condition)
+            return std::nullopt;
+        if (*condition)
+            return Interpreter::execute(parent, tuple->objects[1]);
+
+        size_t i = 2;
+        while (i < tuple->objects.size()) {
+            auto else_s = Interpreter::execute(parent, tuple->objects[i]);
+            if (else_s.to_indirect_reference(context) != context["else"] || i + 1 >= tuple->objects.size())
+                return std::nullopt;
+
+            auto s = Interpreter::execute(parent, tuple->objects[i + 1]);
+            if (s.to_indirect_reference(context) == context["if"] && i + 3 < tuple->objects.size()) {
+                auto else_condition = get_arg<bool>(context, Interpreter::execute(parent, tuple->objects[i + 2]).to_data(context));
+                if (!else_condition)
+                    return std::nullopt;
+                if (*else_condition)
+                    return Interpreter::execute(parent, tuple->objects[i + 3]);
+                i += 4;
+            } else return s;
         }
+        return Reference();
     }
 
     auto const while_statement_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -140,24 +145,22 @@ namespace Interpreter::SystemFunctions::Base {
             )
         }
     ));
-    Reference while_statement(FunctionContext& context) {
-        try {
-            auto& parent = context.get_parent();
-            Reference result;
-
-            auto condition = context["condition"];
-            auto block = context["block"];
-            while (true) {
-                auto c = Interpreter::call_function(parent, nullptr, condition, std::make_shared<Parser::Tuple>()).to_data(context).get<bool>();
-                if (c) {
-                    result = Interpreter::call_function(parent, nullptr, block, std::make_shared<Parser::Tuple>());
-                } else break;
-            }
-
-            return result;
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+    std::optional<Reference> while_statement(FunctionContext& context) {
+        auto& parent = context.get_parent();
+        Reference result;
+
+        auto condition = context["condition"];
+        auto block = context["block"];
+        while (true) {
+            auto c = get_arg<bool>(context, Interpreter::call_function(parent, nullptr, condition, std::make_shared<Parser::Tuple>()).to_data(context));
+            if (!c)
+                return std::nullopt;
+            if (*c) {
+                result = Interpreter::call_function(parent, nullptr, block, std::make_shared<Parser::Tuple>());
+            } else break;
         }
+
+        return result;
     }
 
     auto const for_statement_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -173,21 +176,19 @@ namespace Interpreter::SystemFunctions::Base {
             )
         }
     ));
-    Reference for_statement(FunctionContext& context) {
-        try {
-            auto variable = context["variable"];
-            auto begin = context["begin"].to_data(context).get<OV_INT>();
-            auto end = context["end"].to_data(context).get<OV_INT>();
-            auto block = context["block"];
-
-            for (OV_INT i = begin; i < end; ++i) {
-                Interpreter::set(context, variable, Data(i));
-                Interpreter::call_function(context.get_parent(), nullptr, block, std::make_shared<Parser::Tuple>());
-            }
-            return {};
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+    std::optional<Reference> for_statement(FunctionContext& context) {
+        auto variable = context["variable"];
+        auto begin = get_arg<OV_INT>(context, context["begin"].to_data(context));
+        auto end = get_arg<OV_INT>(context, context["end"].to_data(context));
+        auto block = context["block"];
+        if (!begin || !end)
+            return std::nullopt;
+
+        for (OV_INT i = *begin; i < *end; ++i) {
+            Interpreter::set(context, variable, Data(i));
+            Interpreter::call_function(context.get_parent(), nullptr, block, std::make_shared<Parser::Tuple>());
         }
+        return Reference();
     }
 
     auto const for_step_statement_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -205,32 +206,30 @@ namespace Interpreter::SystemFunctions::Base {
             )
         }
     ));
-    Reference for_step_statement(FunctionContext& context) {
-        try {
-            auto& parent = context.get_parent();
-
-            auto variable = context["variable"];
-            auto begin = context["begin"].to_data(context).get<OV_INT>();
-            auto end = context["end"].to_data(context).get<OV_INT>();
-            auto s = context["s"].to_data(context).get<OV_INT>();
-            auto block = context["block"];
-
-            if (s > 0) {
-                for (OV_INT i = begin; i < end; i += s) {
-                    Interpreter::set(context, variable, Data(i));
-                    Interpreter::call_function(parent, nullptr, block, std::make_shared<Parser::Tuple>());
-                }
-            } else if (s < 0) {
-                for (OV_INT i = begin; i > end; i += s) {
-                    Interpreter::set(context, variable, Data(i));
-                    Interpreter::call_function(parent, nullptr, block, std::make_shared<Parser::Tuple>());
-                }
-            } else throw Interpreter::FunctionArgumentsError();
-
-            return Data(GC::new_object());
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+    std::optional<Reference> for_step_statement(FunctionContext& context) {
+        auto& parent = context.get_parent();
+
+        auto variable = context["variable"];
+        auto begin = get_arg<OV_INT>(context, context["begin"].to_data(context));
+        auto end = get_arg<OV_INT>(context, context["end"].to_data(context));
+        auto s = get_arg<OV_INT>(context, context["s"].to_data(context));
+        auto block = context["block"];
+        if (!begin || !end || !s || *s == 0)
+            return std::nullopt;
+
+        if (*s > 0) {
+            for (OV_INT i = *begin; i < *end; i += *s) {
+                Interpreter::set(context, variable, Data(i));
+                Interpreter::call_function(parent, nullptr, block, std::make_shared<Parser::Tuple>());
+            }
+        } else {
+            for (OV_INT i = *begin; i > *end; i += *s) {
+                Interpreter::set(context, variable, Data(i));
+                Interpreter::call_function(parent, nullptr, block, std::make_shared<Parser::Tuple>());
+            }
         }
+
+        return Data(GC::new_object());
     }
 
     auto const try_statement_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -272,11 +271,10 @@ namespace Interpreter::SystemFunctions::Base {
     Reference copy(FunctionContext& context) {
         auto data = context["data"].to_data(context);
 
-        try {
-            return Data(GC::new_object(*data.get<ObjectPtr>()));
-        } catch (Data::BadAccess const&) {
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            return Data(GC::new_object(**object));
+        else
             return data;
-        }
     }
 
     Reference copy_pointer(FunctionContext& context) {
@@ -292,7 +290,7 @@ namespace Interpreter::SystemFunctions::Base {
             std::make_shared<Parser::Symbol>("data")
         }
     ));
-    Reference define(FunctionContext& context) {
+    std::optional<Reference> define(FunctionContext& context) {
         auto var = Interpreter::call_function(context.get_parent(), nullptr, context["var"], std::make_shared<Parser::Tuple>());
         auto data = context["data"].to_data(context);
 
@@ -303,14 +301,14 @@ namespace Interpreter::SystemFunctions::Base {
                     [&iterate](auto const& r) { return iterate(r); }
                 );
             } else {
-                return reference.to_indirect_reference(context).get_data() != Data{};
+                return Reference(reference.to_indirect_reference(context)).read() != Data{};
             }
         };
 
         if (!iterate(var))
             return Interpreter::set(context, var, data);
         else
-            throw FunctionArgumentsError();
+            return std::nullopt;
     }
 
     auto const function_definition_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -319,23 +317,24 @@ namespace Interpreter::SystemFunctions::Base {
             std::make_shared<Parser::Symbol>("functions")
         }
     ));
-    Reference function_definition(FunctionContext& context) {
-        try {
-            auto object = context["object"];
-            auto functions = context["functions"].to_data(context).get<ObjectPtr>()->functions;
-
-            auto& data = object.get_data();
-            if (data == Data{})
-                data = GC::new_object();
-            auto obj = object.to_data(context).get<ObjectPtr>();
-
-            for (auto const& function : std::ranges::reverse_view(functions))
-                obj->functions.push_front(function);
-
-            return object;
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> function_definition(FunctionContext& context) {
+        auto object = context["object"];
+        auto source = get_arg<ObjectPtr>(context, context["functions"].to_data(context));
+        if (!source)
+            return std::nullopt;
+        auto functions = (*source)->functions;
+
+        auto& data = object.get_data();
+        if (data == Data{})
+            data = GC::new_object();
+        auto obj = get_arg<ObjectPtr>(context, object.to_data(context));
+        if (!obj)
+            return std::nullopt;
+
+        for (auto const& function : std::ranges::reverse_view(functions))
+            (*obj)->functions.push_front(function);
+
+        return object;
     }
 
     auto const function_add_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -344,26 +343,27 @@ namespace Interpreter::SystemFunctions::Base {
             std::make_shared<Parser::Symbol>("functions")
         }
     ));
-    Reference function_add(FunctionContext& context) {
-        try {
-            auto object = context["object"];
-            auto functions = context["functions"].to_data(context).get<ObjectPtr>()->functions;
-
-            auto& data = object.get_data();
-            if (data == Data{})
-                data = GC::new_object();
-            auto obj = object.to_data(context).get<ObjectPtr>();
-
-            for (auto const& function : functions)
-                obj->functions.push_back(function);
-
-            return object;
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> function_add(FunctionContext& context) {
+        auto object = context["object"];
+        auto source = get_arg<ObjectPtr>(context, context["functions"].to_data(context));
+        if (!source)
+            return std::nullopt;
+        auto functions = (*source)->functions;
+
+        auto& data = object.get_data();
+        if (data == Data{})
+            data = GC::new_object();
+        auto obj = get_arg<ObjectPtr>(context, object.to_data(context));
+        if (!obj)
+            return std::nullopt;
+
+        for (auto const& function : functions)
+            (*obj)->functions.push_back(function);
+
+        return object;
     }
 
-    bool eq(Data const& a, Data const& b) {
+    std::optional<bool> eq(Data const& a, Data const& b) {
         if (auto const* a_object = get_if<ObjectPtr>(&a)) {
             if (auto const* b_object = get_if<ObjectPtr>(&b))
                 return (*a_object)->properties == (*b_object)->properties
@@ -382,7 +382,7 @@ namespace Interpreter::SystemFunctions::Base {
         } else if (auto const* a_bool = get_if<bool>(&a)) {
             if (auto const* b_bool = get_if<bool>(&b)) return *a_bool == *b_bool;
             else return false;
-        } else throw FunctionArgumentsError();
+        } else return std::nullopt;
     }
 
     auto const equals_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -391,18 +391,22 @@ namespace Interpreter::SystemFunctions::Base {
             std::make_shared<Parser::Symbol>("b")
         }
     ));
-    Reference equals(FunctionContext& context) {
+    std::optional<Reference> equals(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
-        return Data(eq(a, b));
+        if (auto result = eq(a, b))
+            return Data(*result);
+        return std::nullopt;
     }
 
-    Reference not_equals(FunctionContext& context) {
+    std::optional<Reference> not_equals(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
-        return Data(!eq(a, b));
+        if (auto result = eq(a, b))
+            return Data(!*result);
+        return std::nullopt;
     }
 
     Reference check_pointers(FunctionContext& context) {
@@ -440,11 +444,11 @@ namespace Interpreter::SystemFunctions::Base {
                     prev = true;
                     os << key << ": " << Interpreter::string_from(context, value);
                 }
-                for (auto d : (*object)->array) {
+                for (size_t i = 0; i < (*object)->array.size(); ++i) {
                     if (prev)
                         os << ", ";
                     prev = true;
-                    os << Interpreter::string_from(context, d);
+                    os << Interpreter::string_from(context, (*object)->array.get(i));
                 }
                 os << ")";
             }
@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
@@ -11,9 +12,11 @@
 
 #include "SystemFunction.hpp"
 
+#include "../Counters.hpp"
 #include "../Interpreter.hpp"
 
 #include "../../parser/Expressions.hpp"
+#include "../../parser/Prefetcher.hpp"
 #include "../../parser/Standard.hpp"
 
 
@@ -22,57 +25,100 @@ extern std::vector<std::string> include_path;
 
 namespace Interpreter::SystemFunctions::Dll {
 
-    std::filesystem::path get_canonical_path(FunctionContext& context) {
-        try {
-            auto str = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-
-            auto position = context.caller ? context.caller->position.substr(0, context.caller->position.find(':')) : "";
-            if (position.length() > 0) {
-                try {
-                    auto path = std::filesystem::path(str);
-
-                    if (!path.is_absolute())
-                        path = std::filesystem::path(position) / path;
-                    return std::filesystem::canonical(path);
-                } catch (std::exception const&) {
-                    for (auto const& i : include_path) {
-                        try {
-                            auto path = std::filesystem::path(i) / str;
-
-                            return std::filesystem::canonical(path);
-                        } catch (std::exception const&) {
-                            return str;
-                        }
-                    }
+    /**
+     * Gets the canonical path of an imported file.
+     * @param str the path written in the import.
+     * @param position the path of the file which imports it.
+     * @return the canonical path, or nothing if the file which imports it has no path.
+    */
+    std::optional<std::filesystem::path> get_canonical_path(std::string const& str, std::string const& position) {
+        if (position.length() > 0) {
+            try {
+                auto path = std::filesystem::path(str);
+
+                if (!path.is_absolute())
+                    path = std::filesystem::path(position) / path;
+                return std::filesystem::canonical(path);
+            } catch (std::exception const&) {
+                for (auto const& i : include_path) {
+                    try {
+                        auto path = std::filesystem::path(i) / str;
 
-                    throw Interpreter::FunctionArgumentsError();
+                        return std::filesystem::canonical(path);
+                    } catch (std::exception const&) {
+                        return str;
+                    }
                 }
-            } else throw Interpreter::FunctionArgumentsError();
-        } catch (Data::BadAccess const&) {
-            throw Interpreter::FunctionArgumentsError();
-        }
+
+                return std::nullopt;
+            }
+        } else return std::nullopt;
+    }
+
+    std::optional<std::filesystem::path> get_canonical_path(FunctionContext& context) {
+        auto str = get_arg<std::string>(context, context["path"].to_data(context));
+        if (!str)
+            return std::nullopt;
+
+        auto position = context.caller ? context.caller->position.get_path() : std::string();
+        return get_canonical_path(*str, position);
+    }
+
+    /**
+     * Checks if a file is a source file, which is parsed and executed when it is imported.
+     * @param path the path of the file.
+     * @return true if the file is a source file.
+    */
+    bool is_source_file(std::filesystem::path const& path) {
+        return std::set<std::string>{".fl", ".ov", ".ouv"}.contains(path.extension().string());
     }
 
     auto const path_args = std::make_shared<Parser::Symbol>("path");
 
-    Reference import_system(FunctionContext& context) {
-        try {
-            if (context["path"].to_data(context).get<ObjectPtr>()->to_string() != "system")
-                throw Interpreter::FunctionArgumentsError();
+    /**
+     * Gets the symbols defined by the system functions, which are available in every imported file.
+     * @return the symbols.
+    */
+    std::set<std::string> const& get_builtin_symbols() {
+        static std::set<std::string> const symbols = GlobalContext(nullptr).get_symbols();
+        return symbols;
+    }
 
-            return Data(context.get_global().system);
-        } catch (Data::BadAccess const&) {
-            throw Interpreter::FunctionArgumentsError();
+    /**
+     * Makes the symbols of an imported file available in the tree which imports it.
+     * @param global the global context.
+     * @param root the root of the tree which imports the file.
+     * @param symbols the symbols of the imported file.
+    */
+    void add_symbols(GlobalContext& global, std::shared_ptr<Parser::Expression> const& root, std::set<std::string> const& symbols) {
+        auto it = global.resolvers.find(root);
+        if (it == global.resolvers.end()) {
+            std::erase_if(global.resolvers, [](auto const& resolver) {
+                return resolver.first.expired();
+            });
+            it = global.resolvers.emplace(root, Parser::SymbolResolver(root)).first;
+            it->second.add_symbols(std::set<std::string>(root->symbols));
         }
+        it->second.add_symbols(symbols);
+    }
+
+    std::optional<Reference> import_system(FunctionContext& context) {
+        if (get_arg<std::string>(context, context["path"].to_data(context)) != "system")
+            return std::nullopt;
+
+        return Data(context.get_global().system);
     }
 
 
     // Import source file
 
-    Reference import(FunctionContext& context) {
-        auto path = get_canonical_path(context);
+    std::optional<Reference> import(FunctionContext& context) {
+        auto canonical = get_canonical_path(context);
+        if (!canonical)
+            return std::nullopt;
+        auto const& path = *canonical;
 
-        if (std::set<std::string>{".fl", ".ov", ".ouv"}.contains(path.extension().string())) {
+        if (is_source_file(path)) {
             auto& global = context.get_global();
             auto root = context.caller->get_root();
 
@@ -81,23 +127,20 @@ namespace Interpreter::SystemFunctions::Dll {
                 std::ostringstream oss;
                 std::ifstream src(path);
                 if (src) {
+                    Counters::increment(Counters::Counter::Imports);
+
                     oss << src.rdbuf();
                     std::string code = oss.str();
 
                     try {
-                        auto expression = Parser::Standard(code, path.string()).get_tree();
+                        auto expression = global.prefetcher ? global.prefetcher->get(path, code) : nullptr;
+                        if (!expression)
+                            expression = Parser::Prefetcher::parse(path, code, get_builtin_symbols());
                         global.sources[path] = expression;
+                        add_symbols(global, root, expression->symbols);
 
-                        {
-                            auto symbols = GlobalContext(nullptr).get_symbols();
-                            expression->compute_symbols(symbols);
-                        }
-
-                        {
-                            auto symbols = root->symbols;
-                            symbols.insert(expression->symbols.begin(), expression->symbols.end());
-                            root->compute_symbols(symbols);
-                        }
+                        if (global.prefetcher)
+                            global.prefetcher->prefetch(expression);
 
                         return Interpreter::execute(global, expression);
                     } catch (Parser::Standard::IncompleteCode const&) {
@@ -109,15 +152,11 @@ namespace Interpreter::SystemFunctions::Dll {
                     throw Exception(context, context.caller, "Error: unable to load the source file \"" + path.string() + "\".");
                 }
             } else {
-                auto expression = it->second;
-
-                auto symbols = root->symbols;
-                symbols.insert(expression->symbols.begin(), expression->symbols.end());
-                root->compute_symbols(symbols);
+                add_symbols(global, root, it->second->symbols);
 
-                return {};
+                return Reference();
             }
-        } else throw Interpreter::FunctionArgumentsError();
+        } else return std::nullopt;
     }
 
 
@@ -131,3 +170,28 @@ namespace Interpreter::SystemFunctions::Dll {
     }
 
 }
+
+namespace Interpreter {
+
+    void prefetch_imports(GlobalContext& context, std::shared_ptr<Parser::Expression> const& expression) {
+        if (!context.prefetcher) {
+            std::set<std::filesystem::path> imported;
+            for (auto const& [path, _] : context.sources)
+                imported.insert(path);
+
+            context.prefetcher = std::make_shared<Parser::Prefetcher>(
+                SystemFunctions::Dll::get_builtin_symbols(),
+                [](std::string const& str, std::string const& position) -> std::optional<std::filesystem::path> {
+                    auto path = SystemFunctions::Dll::get_canonical_path(str, position);
+                    if (path && SystemFunctions::Dll::is_source_file(*path))
+                        return path;
+                    return std::nullopt;
+                },
+                imported
+            );
+        }
+
+        context.prefetcher->prefetch(expression);
+    }
+
+}
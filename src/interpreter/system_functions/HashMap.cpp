@@ -0,0 +1,277 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "SystemFunction.hpp"
+
+#include "../Interpreter.hpp"
+
+
+namespace Interpreter::SystemFunctions::HashMap {
+
+    namespace {
+
+        /**
+         * The index of a hash map, whose keys and values are stored in turn in the array of its object so that the GC sees them.
+         * It is an open addressing table with linear probing, each slot holds the index of an entry plus one, or zero if it is free.
+        */
+        struct Table {
+            std::vector<size_t> slots;
+            std::vector<size_t> hashes;
+        };
+
+        /**
+         * Hashes a value, the objects by their identity.
+         * @param data the value.
+         * @return the hash.
+        */
+        size_t hash_value(Data const& data) {
+            if (auto const* object = get_if<ObjectPtr>(&data))
+                return std::hash<Object const*>{}(object->get());
+            else if (auto const* c = get_if<char>(&data))
+                return std::hash<char>{}(*c);
+            else if (auto const* f = get_if<OV_FLOAT>(&data))
+                return *f == 0 ? 0 : std::hash<OV_FLOAT>{}(*f);
+            else if (auto const* i = get_if<OV_INT>(&data))
+                return std::hash<OV_INT>{}(*i);
+            else if (auto const* b = get_if<bool>(&data))
+                return std::hash<bool>{}(*b);
+            else
+                return 0;
+        }
+
+        void combine(size_t& h, size_t value) {
+            h ^= value + 0x9e3779b97f4a7c15 + (h << 6) + (h >> 2);
+        }
+
+        /**
+         * Hashes a key, the objects by their properties and their elements as the builtin == compares them, so that equal tuples and strings have the same hash.
+         * @param key the key.
+         * @return the hash.
+        */
+        size_t hash(Data const& key) {
+            if (auto const* object = get_if<ObjectPtr>(&key)) {
+                size_t h = (*object)->functions.size();
+                for (auto const& [name, value] : (*object)->properties) {
+                    combine(h, std::hash<std::string>{}(name));
+                    combine(h, hash_value(value));
+                }
+                auto const& array = (*object)->array;
+                if (auto const* string = array.get_string()) {
+                    for (auto const c : *string)
+                        combine(h, std::hash<char>{}(c));
+                } else {
+                    for (size_t i = 0; i < array.size(); ++i)
+                        combine(h, hash_value(array.get(i)));
+                }
+                return h;
+            } else
+                return hash_value(key);
+        }
+
+        /**
+         * Compares two keys as the builtin ==, the objects by their properties, their functions and their elements.
+        */
+        bool equals(Data const& a, Data const& b) {
+            if (auto const* a_object = get_if<ObjectPtr>(&a)) {
+                if (auto const* b_object = get_if<ObjectPtr>(&b))
+                    return *a_object == *b_object || (
+                        (*a_object)->properties == (*b_object)->properties
+                        && (*a_object)->functions == (*b_object)->functions
+                        && (*a_object)->array == (*b_object)->array
+                    );
+                else
+                    return false;
+            } else
+                return a == b;
+        }
+
+        std::optional<size_t> find(Table const& table, Array const& entries, Data const& key, size_t h) {
+            if (table.slots.empty())
+                return std::nullopt;
+
+            auto mask = table.slots.size() - 1;
+            for (auto i = h & mask; table.slots[i] != 0; i = (i + 1) & mask) {
+                auto e = table.slots[i] - 1;
+                if (table.hashes[e] == h && equals(entries.get(2 * e), key))
+                    return e;
+            }
+            return std::nullopt;
+        }
+
+        void place(Table& table, size_t e) {
+            auto mask = table.slots.size() - 1;
+            auto i = table.hashes[e] & mask;
+            while (table.slots[i] != 0)
+                i = (i + 1) & mask;
+            table.slots[i] = e + 1;
+        }
+
+        size_t get_slot(Table const& table, size_t e) {
+            auto mask = table.slots.size() - 1;
+            auto i = table.hashes[e] & mask;
+            while (table.slots[i] != e + 1)
+                i = (i + 1) & mask;
+            return i;
+        }
+
+        /**
+         * Copies a key which is a string or a tuple, so that modifying the object given as key does not change the stored key and its hash.
+         * @param key the key.
+         * @return the key to store.
+        */
+        Data copy_key(Data const& key) {
+            if (auto const* object = get_if<ObjectPtr>(&key); object && (*object)->properties.get_shape().size() == 0 && (*object)->functions.empty()) {
+                auto copy = GC::new_object();
+                copy->array = (*object)->array;
+                return Data(copy);
+            } else
+                return key;
+        }
+
+        size_t insert(Table& table, Array& entries, Data const& key, size_t h) {
+            auto e = table.hashes.size();
+            if ((e + 1) * 4 > table.slots.size() * 3) {
+                table.slots.assign(std::max(static_cast<size_t>(8), table.slots.size() * 2), 0);
+                for (size_t i = 0; i < e; ++i)
+                    place(table, i);
+            }
+
+            entries.push_back(copy_key(key));
+            entries.push_back(Data{});
+            table.hashes.push_back(h);
+            place(table, e);
+            return e;
+        }
+
+        void erase(Table& table, Array& entries, size_t e) {
+            // Shifts back the following entries of the cluster instead of leaving a tombstone
+            auto mask = table.slots.size() - 1;
+            auto hole = get_slot(table, e);
+            table.slots[hole] = 0;
+            for (auto i = (hole + 1) & mask; table.slots[i] != 0; i = (i + 1) & mask) {
+                auto ideal = table.hashes[table.slots[i] - 1] & mask;
+                if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                    table.slots[hole] = table.slots[i];
+                    table.slots[i] = 0;
+                    hole = i;
+                }
+            }
+
+            // Moves the last entry in place of the removed one to keep the entries contiguous
+            auto last = table.hashes.size() - 1;
+            if (e != last) {
+                table.slots[get_slot(table, last)] = e + 1;
+                table.hashes[e] = table.hashes[last];
+                entries.set(2 * e, entries.get(2 * last));
+                entries.set(2 * e + 1, entries.get(2 * last + 1));
+            }
+            table.hashes.pop_back();
+            entries.resize(2 * last);
+        }
+
+    }
+
+    bool is_table(Object const& object) {
+        return object.c_obj.get_if<Table>() != nullptr;
+    }
+
+    void restore_table(Object& object) {
+        auto table = std::make_unique<Table>();
+        auto const size = object.array.size() / 2;
+        for (size_t e = 0; e < size; ++e)
+            table->hashes.push_back(hash(object.array.get(2 * e)));
+        auto capacity = static_cast<size_t>(8);
+        while (size * 4 > capacity * 3)
+            capacity *= 2;
+        table->slots.assign(capacity, 0);
+        for (size_t e = 0; e < size; ++e)
+            place(*table, e);
+        object.c_obj.set(std::move(table));
+    }
+
+    Reference hashmap_create() {
+        auto object = GC::new_object();
+        object->c_obj.set(std::make_unique<Table>());
+        return Data(object);
+    }
+
+    std::optional<Reference> hashmap_size(ObjectPtr const& map) {
+        if (auto const* table = map->c_obj.get_if<Table>())
+            return Data(static_cast<OV_INT>(table->hashes.size()));
+        else
+            return std::nullopt;
+    }
+
+    std::optional<Reference> hashmap_get(ObjectPtr const& map, Data const& key) {
+        if (auto* table = map->c_obj.get_if<Table>()) {
+            auto h = hash(key);
+            auto e = find(*table, map->array, key, h);
+            if (!e)
+                e = insert(*table, map->array, key, h);
+            return Data(map).get_at(2 * *e + 1);
+        } else
+            return std::nullopt;
+    }
+
+    std::optional<Reference> hashmap_has(ObjectPtr const& map, Data const& key) {
+        if (auto const* table = map->c_obj.get_if<Table>())
+            return Data(find(*table, map->array, key, hash(key)).has_value());
+        else
+            return std::nullopt;
+    }
+
+    std::optional<Reference> hashmap_find(ObjectPtr const& map, Data const& key) {
+        if (auto const* table = map->c_obj.get_if<Table>()) {
+            auto e = find(*table, map->array, key, hash(key));
+            return Data(e ? static_cast<OV_INT>(*e) : static_cast<OV_INT>(-1));
+        } else
+            return std::nullopt;
+    }
+
+    std::optional<Reference> hashmap_remove(ObjectPtr const& map, Data const& key) {
+        if (auto* table = map->c_obj.get_if<Table>()) {
+            if (auto e = find(*table, map->array, key, hash(key)))
+                erase(*table, map->array, *e);
+            return Data{};
+        } else
+            return std::nullopt;
+    }
+
+    std::optional<Reference> hashmap_entry(ObjectPtr const& map, OV_INT i) {
+        if (auto const* table = map->c_obj.get_if<Table>(); table && i >= 0 && static_cast<size_t>(i) < table->hashes.size())
+            return TupleReference{ Data(map).get_at(2 * i), Data(map).get_at(2 * i + 1) };
+        else
+            return std::nullopt;
+    }
+
+    std::optional<Reference> hashmap_remove_entry(ObjectPtr const& map, OV_INT i) {
+        if (auto* table = map->c_obj.get_if<Table>(); table && i >= 0 && static_cast<size_t>(i) < table->hashes.size()) {
+            erase(*table, map->array, i);
+            return Data{};
+        } else
+            return std::nullopt;
+    }
+
+
+    void init(GlobalContext& context) {
+        auto s = context.get_global().system;
+
+        add_function(s.get_property("hashmap_create"), hashmap_create);
+        add_function(s.get_property("hashmap_size"), hashmap_size);
+        add_function(s.get_property("hashmap_get"), hashmap_get);
+        add_function(s.get_property("hashmap_has"), hashmap_has);
+        add_function(s.get_property("hashmap_find"), hashmap_find);
+        add_function(s.get_property("hashmap_remove"), hashmap_remove);
+        add_function(s.get_property("hashmap_entry"), hashmap_entry);
+        add_function(s.get_property("hashmap_remove_entry"), hashmap_remove_entry);
+    }
+
+}
@@ -2,6 +2,7 @@
 #include <cstdlib>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <random>
 #include <variant>
 
@@ -34,42 +35,38 @@ namespace Interpreter::SystemFunctions::Math {
     ));
 
     Reference logical_not(bool a) {
-        try {
-            return Data(!a);
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(!a);
     }
 
-    Reference logical_and(FunctionContext& context) {
-        try {
-            auto a = context["a"].to_data(context).get<bool>();
-            auto b = context["b"];
-
-            if (a)
-                return Data(Interpreter::call_function(context.get_parent(), nullptr, b, std::make_shared<Parser::Tuple>()).to_data(context).get<bool>());
-            else
-                return Data(false);
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> logical_and(FunctionContext& context) {
+        auto a = context["a"].to_data(context);
+        auto const* a_bool = get_if<bool>(&a);
+        if (!a_bool)
+            return std::nullopt;
+        if (!*a_bool)
+            return Data(false);
+
+        auto b = Interpreter::call_function(context.get_parent(), nullptr, context["b"], std::make_shared<Parser::Tuple>()).to_data(context);
+        if (auto const* b_bool = get_if<bool>(&b))
+            return Data(*b_bool);
+        return std::nullopt;
     }
 
-    Reference logical_or(FunctionContext& context) {
-        try {
-            auto a = context["a"].to_data(context).get<bool>();
-            auto b = context["b"];
-
-            if (!a)
-                return Data(Interpreter::call_function(context.get_parent(), nullptr, b, std::make_shared<Parser::Tuple>()).to_data(context).get<bool>());
-            else
-                return Data(true);
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> logical_or(FunctionContext& context) {
+        auto a = context["a"].to_data(context);
+        auto const* a_bool = get_if<bool>(&a);
+        if (!a_bool)
+            return std::nullopt;
+        if (*a_bool)
+            return Data(true);
+
+        auto b = Interpreter::call_function(context.get_parent(), nullptr, context["b"], std::make_shared<Parser::Tuple>()).to_data(context);
+        if (auto const* b_bool = get_if<bool>(&b))
+            return Data(*b_bool);
+        return std::nullopt;
     }
 
-    Reference addition(Data const& a, Data const& b) {
+    std::optional<Reference> addition(Data const& a, Data const& b) {
         if (auto const* a_int = get_if<OV_INT>(&a)) {
             if (auto const* b_int = get_if<OV_INT>(&b))
                 return Data(*a_int + *b_int);
@@ -81,20 +78,20 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return Data(*a_float + *b_float);
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference opposite(FunctionContext& context) {
+    std::optional<Reference> opposite(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (auto const* a_int = get_if<OV_INT>(&a))
             return Data(-*a_int);
         else if (auto const* a_float = get_if<OV_FLOAT>(&a))
             return Data(-*a_float);
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference substraction(FunctionContext& context) {
+    std::optional<Reference> substraction(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -109,10 +106,10 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return Data(*a_float - *b_float);
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference multiplication(FunctionContext& context) {
+    std::optional<Reference> multiplication(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -127,10 +124,10 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return Data(*a_float * *b_float);
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference division(FunctionContext& context) {
+    std::optional<Reference> division(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -145,20 +142,20 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return Data(*a_float / *b_float);
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference modulo(FunctionContext& context) {
+    std::optional<Reference> modulo(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
         if (auto const* a_int = get_if<OV_INT>(&a))
             if (auto const* b_int = get_if<OV_INT>(&b))
                 return Data(*a_int % *b_int);
-        throw Interpreter::FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference strictly_inf(FunctionContext& context) {
+    std::optional<Reference> strictly_inf(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -176,10 +173,10 @@ namespace Interpreter::SystemFunctions::Math {
         if (auto const* a_char = get_if<char>(&a))
             if (auto const* b_char = get_if<char>(&b))
                 return Data(*a_char < *b_char);
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference strictly_sup(FunctionContext& context) {
+    std::optional<Reference> strictly_sup(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -197,10 +194,10 @@ namespace Interpreter::SystemFunctions::Math {
         if (auto const* a_char = get_if<char>(&a))
             if (auto const* b_char = get_if<char>(&b))
                 return Data(*a_char > *b_char);
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference inf_equals(FunctionContext& context) {
+    std::optional<Reference> inf_equals(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -218,10 +215,10 @@ namespace Interpreter::SystemFunctions::Math {
         if (auto const* a_char = get_if<char>(&a))
             if (auto const* b_char = get_if<char>(&b))
                 return Data(*a_char <= *b_char);
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference sup_equals(FunctionContext& context) {
+    std::optional<Reference> sup_equals(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -239,30 +236,28 @@ namespace Interpreter::SystemFunctions::Math {
         if (auto const* a_char = get_if<char>(&a))
             if (auto const* b_char = get_if<char>(&b))
                 return Data(*a_char >= *b_char);
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference increment(FunctionContext& context) {
+    std::optional<Reference> increment(FunctionContext& context) {
         auto a = context["a"];
 
-        try {
-            return set(context, a, Data(a.to_data(context).get<OV_INT>() + 1));
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        auto data = a.to_data(context);
+        if (auto const* a_int = get_if<OV_INT>(&data))
+            return set(context, a, Data(*a_int + 1));
+        return std::nullopt;
     }
 
-    Reference decrement(FunctionContext& context) {
+    std::optional<Reference> decrement(FunctionContext& context) {
         auto a = context["a"];
 
-        try {
-            return set(context, a, Data(a.to_data(context).get<OV_INT>() - 1));
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        auto data = a.to_data(context);
+        if (auto const* a_int = get_if<OV_INT>(&data))
+            return set(context, a, Data(*a_int - 1));
+        return std::nullopt;
     }
 
-    Reference add(FunctionContext& context) {
+    std::optional<Reference> add(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -277,10 +272,10 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return set(context, context["a"], Data(*a_float + *b_float));
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference remove(FunctionContext& context) {
+    std::optional<Reference> remove(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -295,10 +290,10 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return set(context, context["a"], Data(*a_float - *b_float));
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference mutiply(FunctionContext& context) {
+    std::optional<Reference> mutiply(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -313,10 +308,10 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return set(context, context["a"], Data(*a_float * *b_float));
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference divide(FunctionContext& context) {
+    std::optional<Reference> divide(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -331,7 +326,7 @@ namespace Interpreter::SystemFunctions::Math {
             else if (auto const* b_float = get_if<OV_FLOAT>(&b))
                 return set(context, context["a"], Data(*a_float / *b_float));
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
     auto const for_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -343,62 +338,80 @@ namespace Interpreter::SystemFunctions::Math {
             std::make_shared<Parser::Symbol>("function")
         }
     ));
-    Reference forall(FunctionContext& context) {
-        try {
-            auto array = Interpreter::call_function(context.get_parent(), nullptr, context["array"], std::make_shared<Parser::Tuple>());
-            auto functions = context["function"];
-
-            bool value = true;
-
-            if (auto* tuple = std::get_if<TupleReference>(&array)) {
-                for (auto const& r : *tuple) {
-                    if (!Interpreter::call_function(context.get_parent(), nullptr, functions, r).to_data(context).get<bool>()) {
-                        value = false;
-                        break;
-                    }
-                }
-            } else {
-                for (auto const& d : array.to_data(context).get<ObjectPtr>()->array) {
-                    if (!Interpreter::call_function(context.get_parent(), nullptr, functions, d).to_data(context).get<bool>()) {
-                        value = false;
-                        break;
-                    }
-                }
+    std::optional<Reference> forall(FunctionContext& context) {
+        auto array = Interpreter::call_function(context.get_parent(), nullptr, context["array"], std::make_shared<Parser::Tuple>());
+        auto functions = context["function"];
+
+        // The predicate must return a boolean for each element it is called with
+        auto const test = [&context, &functions](Reference const& r) -> std::optional<bool> {
+            auto const result = Interpreter::call_function(context.get_parent(), nullptr, functions, r).to_data(context);
+            if (auto const* b = get_if<bool>(&result))
+                return !*b;
+            else
+                return std::nullopt;
+        };
+
+        if (auto* tuple = std::get_if<TupleReference>(&array)) {
+            for (auto const& r : *tuple) {
+                auto const found = test(r);
+                if (!found)
+                    return std::nullopt;
+                else if (*found)
+                    return Data(false);
+            }
+        } else {
+            auto data = array.to_data(context);
+            auto const* obj = get_if<ObjectPtr>(&data);
+            if (!obj)
+                return std::nullopt;
+            for (size_t i = 0; i < (*obj)->array.size(); ++i) {
+                auto const found = test((*obj)->array.get(i));
+                if (!found)
+                    return std::nullopt;
+                else if (*found)
+                    return Data(false);
             }
-
-            return Data{ value };
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
         }
+
+        return Data(true);
     }
 
-    Reference exists(FunctionContext& context) {
-        try {
-            auto array = Interpreter::call_function(context.get_parent(), nullptr, context["array"], std::make_shared<Parser::Tuple>());
-            auto functions = context["function"];
-
-            bool value = false;
-
-            if (auto* tuple = std::get_if<TupleReference>(&array)) {
-                for (auto const& r : *tuple) {
-                    if (Interpreter::call_function(context.get_parent(), nullptr, functions, r).to_data(context).get<bool>()) {
-                        value = true;
-                        break;
-                    }
-                }
-            } else {
-                for (auto const& d : array.to_data(context).get<ObjectPtr>()->array) {
-                    if (Interpreter::call_function(context.get_parent(), nullptr, functions, d).to_data(context).get<bool>()) {
-                        value = true;
-                        break;
-                    }
-                }
-            }
+    std::optional<Reference> exists(FunctionContext& context) {
+        auto array = Interpreter::call_function(context.get_parent(), nullptr, context["array"], std::make_shared<Parser::Tuple>());
+        auto functions = context["function"];
 
-            return Data{ value };
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
+        // The predicate must return a boolean for each element it is called with
+        auto const test = [&context, &functions](Reference const& r) -> std::optional<bool> {
+            auto const result = Interpreter::call_function(context.get_parent(), nullptr, functions, r).to_data(context);
+            if (auto const* b = get_if<bool>(&result))
+                return *b;
+            else
+                return std::nullopt;
+        };
+
+        if (auto* tuple = std::get_if<TupleReference>(&array)) {
+            for (auto const& r : *tuple) {
+                auto const found = test(r);
+                if (!found)
+                    return std::nullopt;
+                else if (*found)
+                    return Data(true);
+            }
+        } else {
+            auto data = array.to_data(context);
+            auto const* obj = get_if<ObjectPtr>(&data);
+            if (!obj)
+                return std::nullopt;
+            for (size_t i = 0; i < (*obj)->array.size(); ++i) {
+                auto const found = test((*obj)->array.get(i));
+                if (!found)
+                    return std::nullopt;
+                else if (*found)
+                    return Data(true);
+            }
         }
+
+        return Data(false);
     }
 
     thread_local std::mt19937 randgen(std::random_device{}());
@@ -408,7 +421,7 @@ namespace Interpreter::SystemFunctions::Math {
         return Data(dis(randgen));
     }
 
-    Reference random_1(FunctionContext& context) {
+    std::optional<Reference> random_1(FunctionContext& context) {
         auto b = context["b"].to_data(context);
 
         if (auto const* b_int = get_if<OV_INT>(&b)) {
@@ -418,10 +431,10 @@ namespace Interpreter::SystemFunctions::Math {
             std::uniform_real_distribution<OV_FLOAT> dis(0, *b_float);
             return Data(dis(randgen));
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference random_2(FunctionContext& context) {
+    std::optional<Reference> random_2(FunctionContext& context) {
         auto a = context["a"].to_data(context);
         auto b = context["b"].to_data(context);
 
@@ -442,30 +455,42 @@ namespace Interpreter::SystemFunctions::Math {
                 return Data(dis(randgen));
             }
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    OV_FLOAT get_OV_FLOAT(Data const& data) {
+    std::optional<OV_FLOAT> get_OV_FLOAT(Data const& data) {
         if (auto const* data_int = get_if<OV_INT>(&data))
             return static_cast<OV_FLOAT>(*data_int);
         else if (auto const* data_float = get_if<OV_FLOAT>(&data))
             return *data_float;
-        else throw FunctionArgumentsError();
+        else
+            return std::nullopt;
     }
 
     template<OV_FLOAT(*function)(OV_FLOAT)>
-    Reference function1(FunctionContext& context) {
-        return Data(function(get_OV_FLOAT(context["a"].to_data(context))));
+    std::optional<Reference> function1(FunctionContext& context) {
+        if (auto const a = get_OV_FLOAT(context["a"].to_data(context)))
+            return Data(function(*a));
+        else
+            return std::nullopt;
     }
 
     template<OV_FLOAT(*function)(OV_FLOAT, OV_FLOAT)>
-    Reference function2(FunctionContext& context) {
-        return Data(function(get_OV_FLOAT(context["a"].to_data(context)), get_OV_FLOAT(context["b"].to_data(context))));
+    std::optional<Reference> function2(FunctionContext& context) {
+        auto const a = get_OV_FLOAT(context["a"].to_data(context));
+        auto const b = get_OV_FLOAT(context["b"].to_data(context));
+        if (a && b)
+            return Data(function(*a, *b));
+        else
+            return std::nullopt;
     }
 
     template<bool (*function)(OV_FLOAT)>
-    Reference function_bool(FunctionContext& context) {
-        return Data(function(get_OV_FLOAT(context["a"].to_data(context))));
+    std::optional<Reference> function_bool(FunctionContext& context) {
+        if (auto const a = get_OV_FLOAT(context["a"].to_data(context)))
+            return Data(function(*a));
+        else
+            return std::nullopt;
     }
 
     void init(GlobalContext& context) {
@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "SystemFunction.hpp"
+
+#include "../Interpreter.hpp"
+
+#if defined(__GNUC__) && defined(__x86_64__) && SIZE_MAX == UINT64_MAX
+#define OUVERIUM_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace Interpreter::SystemFunctions::Matrix {
+
+    namespace {
+
+        using Buffer = std::vector<OV_FLOAT>;
+
+        // The matrices are stored by column, as the first index of an element is the fastest to vary
+        size_t const block_rows = 256;
+        size_t const block_inner = 64;
+        size_t const block_transpose = 32;
+        size_t const parallel_threshold = size_t(1) << 21;
+
+        namespace scalar {
+
+            void axpy(size_t n, OV_FLOAT alpha, OV_FLOAT const* x, OV_FLOAT* y) {
+                for (size_t i = 0; i < n; ++i)
+                    y[i] += alpha * x[i];
+            }
+
+            OV_FLOAT dot(size_t n, OV_FLOAT const* x, OV_FLOAT const* y) {
+                OV_FLOAT s[4] = {};
+                size_t i = 0;
+                for (; i + 4 <= n; i += 4)
+                    for (size_t j = 0; j < 4; ++j)
+                        s[j] += x[i + j] * y[i + j];
+                for (; i < n; ++i)
+                    s[0] += x[i] * y[i];
+                return (s[0] + s[1]) + (s[2] + s[3]);
+            }
+
+            OV_FLOAT sum(size_t n, OV_FLOAT const* x) {
+                OV_FLOAT s[4] = {};
+                size_t i = 0;
+                for (; i + 4 <= n; i += 4)
+                    for (size_t j = 0; j < 4; ++j)
+                        s[j] += x[i + j];
+                for (; i < n; ++i)
+                    s[0] += x[i];
+                return (s[0] + s[1]) + (s[2] + s[3]);
+            }
+
+        }
+
+#ifdef OUVERIUM_AVX2
+        namespace avx2 {
+
+            __attribute__((target("avx2,fma")))
+            void axpy(size_t n, OV_FLOAT alpha, OV_FLOAT const* x, OV_FLOAT* y) {
+                auto a = _mm256_set1_pd(alpha);
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    _mm256_storeu_pd(y + i, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+                    _mm256_storeu_pd(y + i + 4, _mm256_fmadd_pd(a, _mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4)));
+                }
+                for (; i < n; ++i)
+                    y[i] += alpha * x[i];
+            }
+
+            __attribute__((target("avx2,fma")))
+            OV_FLOAT dot(size_t n, OV_FLOAT const* x, OV_FLOAT const* y) {
+                auto s0 = _mm256_setzero_pd();
+                auto s1 = _mm256_setzero_pd();
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    s0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), s0);
+                    s1 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), s1);
+                }
+                alignas(32) OV_FLOAT s[4];
+                _mm256_store_pd(s, _mm256_add_pd(s0, s1));
+                auto sum = (s[0] + s[1]) + (s[2] + s[3]);
+                for (; i < n; ++i)
+                    sum += x[i] * y[i];
+                return sum;
+            }
+
+            __attribute__((target("avx2,fma")))
+            OV_FLOAT sum(size_t n, OV_FLOAT const* x) {
+                auto s0 = _mm256_setzero_pd();
+                auto s1 = _mm256_setzero_pd();
+                size_t i = 0;
+                for (; i + 8 <= n; i += 8) {
+                    s0 = _mm256_add_pd(_mm256_loadu_pd(x + i), s0);
+                    s1 = _mm256_add_pd(_mm256_loadu_pd(x + i + 4), s1);
+                }
+                alignas(32) OV_FLOAT s[4];
+                _mm256_store_pd(s, _mm256_add_pd(s0, s1));
+                auto sum = (s[0] + s[1]) + (s[2] + s[3]);
+                for (; i < n; ++i)
+                    sum += x[i];
+                return sum;
+            }
+
+        }
+#endif
+
+        /**
+         * The vector kernels, chosen once according to the instructions supported by the processor.
+        */
+        struct Kernels {
+            void (*axpy)(size_t n, OV_FLOAT alpha, OV_FLOAT const* x, OV_FLOAT* y);
+            OV_FLOAT(*dot)(size_t n, OV_FLOAT const* x, OV_FLOAT const* y);
+            OV_FLOAT(*sum)(size_t n, OV_FLOAT const* x);
+        };
+
+        Kernels const kernels = [] {
+#ifdef OUVERIUM_AVX2
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+                return Kernels{ avx2::axpy, avx2::dot, avx2::sum };
+#endif
+            return Kernels{ scalar::axpy, scalar::dot, scalar::sum };
+        }();
+
+        /**
+         * Computes the columns from j_begin to j_end of the product c of a and b.
+         * The blocks of a are kept in cache while they are used for all the columns.
+        */
+        void multiply_columns(OV_FLOAT const* a, OV_FLOAT const* b, OV_FLOAT* c, size_t rows, size_t inner, size_t j_begin, size_t j_end) {
+            for (size_t kb = 0; kb < inner; kb += block_inner) {
+                auto k_end = std::min(inner, kb + block_inner);
+                for (size_t ib = 0; ib < rows; ib += block_rows) {
+                    auto n = std::min(block_rows, rows - ib);
+                    for (size_t j = j_begin; j < j_end; ++j)
+                        for (size_t k = kb; k < k_end; ++k)
+                            kernels.axpy(n, b[k + j * inner], a + ib + k * rows, c + ib + j * rows);
+                }
+            }
+        }
+
+        void multiply(OV_FLOAT const* a, OV_FLOAT const* b, OV_FLOAT* c, size_t rows, size_t inner, size_t cols) {
+            size_t threads = 1;
+            if (rows * inner * cols >= parallel_threshold)
+                threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), cols);
+
+            if (threads <= 1) {
+                multiply_columns(a, b, c, rows, inner, 0, cols);
+            } else {
+                // The workers are joined when they are destroyed, also if starting one of them throws
+                std::vector<std::jthread> workers;
+                auto chunk = (cols + threads - 1) / threads;
+                workers.reserve(threads - 1);
+                for (size_t j = chunk; j < cols; j += chunk)
+                    workers.emplace_back(multiply_columns, a, b, c, rows, inner, j, std::min(cols, j + chunk));
+                multiply_columns(a, b, c, rows, inner, 0, std::min(cols, chunk));
+            }
+        }
+
+        /**
+         * Computes the number of elements of a matrix without overflowing.
+         * @param rows the number of rows.
+         * @param cols the number of columns.
+         * @return the number of elements, or nothing if the dimensions are negative or if a buffer can not hold it.
+        */
+        std::optional<size_t> get_size(OV_INT rows, OV_INT cols) {
+            if (rows < 0 || cols < 0)
+                return std::nullopt;
+
+            auto const r = static_cast<uint64_t>(rows);
+            auto const c = static_cast<uint64_t>(cols);
+            if (c != 0 && r > Buffer().max_size() / c)
+                return std::nullopt;
+            return static_cast<size_t>(r * c);
+        }
+
+        Buffer const* get_buffer(ObjectPtr const& array) {
+            return array->array.get_buffer<OV_FLOAT>();
+        }
+
+        Reference make_array(Buffer&& buffer) {
+            buffer.reserve(std::max(static_cast<size_t>(1), buffer.size()));
+
+            auto object = GC::new_object();
+            object->array = Interpreter::Array(std::move(buffer));
+            return Data(object);
+        }
+
+    }
+
+    std::optional<Reference> matrix_multiply(ObjectPtr const& a, ObjectPtr const& b, OV_INT rows, OV_INT inner, OV_INT cols) {
+        auto const* x = get_buffer(a);
+        auto const* y = get_buffer(b);
+        if (!x || !y)
+            return std::nullopt;
+        auto const x_size = get_size(rows, inner);
+        auto const y_size = get_size(inner, cols);
+        auto const c_size = get_size(rows, cols);
+        if (!x_size || !y_size || !c_size || x->size() != *x_size || y->size() != *y_size)
+            return std::nullopt;
+
+        Buffer c(*c_size);
+        multiply(x->data(), y->data(), c.data(), rows, inner, cols);
+        return make_array(std::move(c));
+    }
+
+    std::optional<Reference> matrix_transpose(ObjectPtr const& a, OV_INT rows, OV_INT cols) {
+        auto const* x = get_buffer(a);
+        if (!x)
+            return std::nullopt;
+        auto const size = get_size(rows, cols);
+        if (!size || x->size() != *size)
+            return std::nullopt;
+
+        Buffer t(x->size());
+        for (size_t jb = 0; jb < static_cast<size_t>(cols); jb += block_transpose)
+            for (size_t ib = 0; ib < static_cast<size_t>(rows); ib += block_transpose)
+                for (size_t j = jb; j < std::min<size_t>(cols, jb + block_transpose); ++j)
+                    for (size_t i = ib; i < std::min<size_t>(rows, ib + block_transpose); ++i)
+                        t[j + i * cols] = (*x)[i + j * rows];
+        return make_array(std::move(t));
+    }
+
+    std::optional<Reference> matrix_add(ObjectPtr const& a, ObjectPtr const& b) {
+        auto const* x = get_buffer(a);
+        auto const* y = get_buffer(b);
+        if (!x || !y || x->size() != y->size())
+            return std::nullopt;
+
+        Buffer c(*y);
+        kernels.axpy(c.size(), 1, x->data(), c.data());
+        return make_array(std::move(c));
+    }
+
+    std::optional<Reference> matrix_sub(ObjectPtr const& a, ObjectPtr const& b) {
+        auto const* x = get_buffer(a);
+        auto const* y = get_buffer(b);
+        if (!x || !y || x->size() != y->size())
+            return std::nullopt;
+
+        Buffer c(*x);
+        kernels.axpy(c.size(), -1, y->data(), c.data());
+        return make_array(std::move(c));
+    }
+
+    std::optional<Reference> matrix_scale(ObjectPtr const& a, OV_FLOAT s) {
+        auto const* x = get_buffer(a);
+        if (!x)
+            return std::nullopt;
+
+        // The elements are multiplied in place, as adding them to zeros would turn -0.0 into 0.0
+        Buffer c(*x);
+        for (auto& e : c)
+            e *= s;
+        return make_array(std::move(c));
+    }
+
+    std::optional<Reference> matrix_dot(ObjectPtr const& a, ObjectPtr const& b) {
+        auto const* x = get_buffer(a);
+        auto const* y = get_buffer(b);
+        if (!x || !y || x->size() != y->size())
+            return std::nullopt;
+
+        return Data(kernels.dot(x->size(), x->data(), y->data()));
+    }
+
+    std::optional<Reference> matrix_sum(ObjectPtr const& a) {
+        auto const* x = get_buffer(a);
+        if (!x)
+            return std::nullopt;
+
+        return Data(kernels.sum(x->size(), x->data()));
+    }
+
+    std::optional<Reference> matrix_min(ObjectPtr const& a) {
+        auto const* x = get_buffer(a);
+        if (!x || x->empty())
+            return std::nullopt;
+
+        return Data(*std::min_element(x->begin(), x->end()));
+    }
+
+    std::optional<Reference> matrix_max(ObjectPtr const& a) {
+        auto const* x = get_buffer(a);
+        if (!x || x->empty())
+            return std::nullopt;
+
+        return Data(*std::max_element(x->begin(), x->end()));
+    }
+
+
+    void init(GlobalContext& context) {
+        auto s = context.get_global().system;
+
+        add_function(s.get_property("matrix_multiply"), matrix_multiply);
+        add_function(s.get_property("matrix_transpose"), matrix_transpose);
+        add_function(s.get_property("matrix_add"), matrix_add);
+        add_function(s.get_property("matrix_sub"), matrix_sub);
+        add_function(s.get_property("matrix_scale"), matrix_scale);
+        add_function(s.get_property("matrix_dot"), matrix_dot);
+        add_function(s.get_property("matrix_sum"), matrix_sum);
+        add_function(s.get_property("matrix_min"), matrix_min);
+        add_function(s.get_property("matrix_max"), matrix_max);
+    }
+
+}
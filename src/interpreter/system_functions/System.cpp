@@ -1,5 +1,5 @@
-#include <any>
 #include <chrono>
+#include <cstddef>
 #include <ctime>
 #include <exception>
 #include <filesystem>
@@ -8,6 +8,7 @@
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -15,10 +16,15 @@
 
 #include <boost/asio.hpp>
 
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
 #include <ouverium/types.h>
 
 #include "SystemFunction.hpp"
 
+#include "../Counters.hpp"
 #include "../Interpreter.hpp"
 
 #include "../../parser/Expressions.hpp"
@@ -26,48 +32,43 @@
 
 namespace Interpreter::SystemFunctions::System {
 
+    /**
+     * Gets a stream argument.
+     * @param context the context of the call.
+     * @param symbol the symbol of the argument.
+     * @return the stream, or nullptr if the argument is not a stream of this type.
+    */
+    template<typename Stream>
+    Stream* get_stream(FunctionContext& context, std::string const& symbol) {
+        return dynamic_cast<Stream*>(get_native<std::ios>(context, symbol));
+    }
+
     auto const stream_is_args = std::make_shared<Parser::Symbol>("stream");
     Reference stream_is(FunctionContext& context) {
-        try {
-            context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>();
-
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+        return Data(get_native<std::ios>(context, "stream") != nullptr);
     }
 
     auto const stream_has_args = std::make_shared<Parser::Symbol>("stream");
-    Reference stream_has(FunctionContext& context) {
-        try {
-            auto& stream = context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>();
+    std::optional<Reference> stream_has(FunctionContext& context) {
+        auto* stream = get_native<std::ios>(context, "stream");
+        if (!stream)
+            return std::nullopt;
 
-            return Data(static_cast<bool>(stream));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(static_cast<bool>(*stream));
     }
 
     auto const istream_is_args = std::make_shared<Parser::Symbol>("stream");
     Reference istream_is(FunctionContext& context) {
-        try {
-            dynamic_cast<std::istream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
-
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+        return Data(get_stream<std::istream>(context, "stream") != nullptr);
     }
 
     auto const stream_read1_args = std::make_shared<Parser::Symbol>("stream");
-    Reference stream_read1(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::istream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
+    std::optional<Reference> stream_read1(FunctionContext& context) {
+        auto* stream = get_stream<std::istream>(context, "stream");
+        if (!stream)
+            return std::nullopt;
 
-            return Data(static_cast<char>(stream.get()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(static_cast<char>(stream->get()));
     }
 
     auto const stream_read2_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -76,59 +77,46 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("size")
         }
     ));
-    Reference stream_read2(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::istream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
-            auto size = static_cast<size_t>(context["size"].to_data(context).get<OV_INT>());
-
-            std::vector<char> buffer(size);
-            stream.read(buffer.data(), static_cast<long>(size));
+    std::optional<Reference> stream_read2(FunctionContext& context) {
+        auto* stream = get_stream<std::istream>(context, "stream");
+        auto size = get_arg<OV_INT>(context, context["size"].to_data(context));
+        if (!stream || !size || *size < 0)
+            return std::nullopt;
 
-            auto object = GC::new_object();
-            object->array.reserve(size);
-            for (size_t i = 0; i < size; ++i)
-                object->array.emplace_back(buffer[i]);
+        try {
+            std::vector<char> buffer(static_cast<size_t>(*size));
+            stream->read(buffer.data(), static_cast<long>(buffer.size()));
 
-            return Data(object);
+            return Data(GC::new_object(std::string(buffer.data(), buffer.size())));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
     auto const stream_get_available_args = std::make_shared<Parser::Symbol>("stream");
-    Reference stream_get_available(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::istream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
+    std::optional<Reference> stream_get_available(FunctionContext& context) {
+        auto* stream = get_stream<std::istream>(context, "stream");
+        if (!stream)
+            return std::nullopt;
 
-            return Data(static_cast<OV_INT>(stream.rdbuf()->in_avail()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(static_cast<OV_INT>(stream->rdbuf()->in_avail()));
     }
 
     auto const stream_scan_args = std::make_shared<Parser::Symbol>("stream");
-    Reference stream_scan(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::istream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
+    std::optional<Reference> stream_scan(FunctionContext& context) {
+        auto* stream = get_stream<std::istream>(context, "stream");
+        if (!stream)
+            return std::nullopt;
 
-            std::string str;
-            std::getline(stream, str);
+        std::string str;
+        std::getline(*stream, str);
 
-            return Data(GC::new_object(str));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(GC::new_object(str));
     }
 
     auto const ostream_is_args = std::make_shared<Parser::Symbol>("stream");
     Reference ostream_is(FunctionContext& context) {
-        try {
-            dynamic_cast<std::ostream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
-
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+        return Data(get_stream<std::ostream>(context, "stream") != nullptr);
     }
 
     auto const stream_write1_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -137,17 +125,15 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("byte")
         }
     ));
-    Reference stream_write1(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::ostream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
-            auto byte = context["byte"].to_data(context).get<char>();
+    std::optional<Reference> stream_write1(FunctionContext& context) {
+        auto* stream = get_stream<std::ostream>(context, "stream");
+        auto byte = get_arg<char>(context, context["byte"].to_data(context));
+        if (!stream || !byte)
+            return std::nullopt;
 
-            stream.put(byte);
+        stream->put(*byte);
 
-            return {};
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Reference();
     }
 
     auto const stream_write2_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -156,33 +142,26 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("bytes")
         }
     ));
-    Reference stream_write2(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::ostream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
-            auto bytes = context["bytes"].to_data(context).get<ObjectPtr>();
+    std::optional<Reference> stream_write2(FunctionContext& context) {
+        auto* stream = get_stream<std::ostream>(context, "stream");
+        auto buffer = get_arg<std::string>(context, context["bytes"].to_data(context));
+        if (!stream || !buffer)
+            return std::nullopt;
 
-            std::vector<char> buffer(bytes->array.size());
-            for (size_t i = 0; i < buffer.size(); ++i)
-                buffer[i] = bytes->array[i].get<char>();
-            stream.write(buffer.data(), static_cast<long>(buffer.size()));
+        stream->write(buffer->data(), static_cast<long>(buffer->size()));
 
-            return {};
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Reference();
     }
 
     auto const stream_flush_args = std::make_shared<Parser::Symbol>("stream");
-    Reference stream_flush(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::ostream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
+    std::optional<Reference> stream_flush(FunctionContext& context) {
+        auto* stream = get_stream<std::ostream>(context, "stream");
+        if (!stream)
+            return std::nullopt;
 
-            stream.flush();
+        stream->flush();
 
-            return {};
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Reference();
     }
 
     auto const stream_print_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -191,125 +170,137 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("data")
         }
     ));
-    Reference stream_print(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::ostream&>(context["stream"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
-            auto data = context["data"].to_data(context);
+    std::optional<Reference> stream_print(FunctionContext& context) {
+        auto* stream = get_stream<std::ostream>(context, "stream");
+        if (!stream)
+            return std::nullopt;
+        auto data = context["data"].to_data(context);
 
-            stream << Interpreter::string_from(context, data);
+        *stream << Interpreter::string_from(context, data);
 
-            return Reference();
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Reference();
     }
 
 
     auto const file_is_args = std::make_shared<Parser::Symbol>("file");
     Reference file_is(FunctionContext& context) {
-        try {
-            dynamic_cast<std::fstream&>(context["file"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
+        return Data(get_stream<std::fstream>(context, "file") != nullptr);
+    }
 
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+    /**
+     * Gets a path argument.
+     * @param context the context of the call.
+     * @param symbol the symbol of the argument.
+     * @return the path, or nothing if the argument is not an object.
+    */
+    std::optional<std::filesystem::path> get_path(FunctionContext& context, std::string const& symbol) {
+        if (auto str = get_arg<std::string>(context, context[symbol].to_data(context)))
+            return std::filesystem::path(*str);
+        return std::nullopt;
     }
 
     auto const file_path_args = std::make_shared<Parser::Symbol>("path");
-    Reference file_open(FunctionContext& context) {
-        try {
-            auto path = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_open(FunctionContext& context) {
+        auto path = get_path(context, "path");
+        if (!path)
+            return std::nullopt;
 
-            auto object = GC::new_object();
-            object->c_obj.set<std::ios>(std::make_unique<std::fstream>(path));
+        auto object = GC::new_object();
+        object->c_obj.set<std::ios>(std::make_unique<std::fstream>(*path));
 
-            return Data(object);
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(object);
     }
 
     auto const file_close_args = std::make_shared<Parser::Symbol>("file");
-    Reference file_close(FunctionContext& context) {
-        try {
-            auto& stream = dynamic_cast<std::fstream&>(context["file"].to_data(context).get<ObjectPtr>()->c_obj.get<std::ios>());
+    std::optional<Reference> file_close(FunctionContext& context) {
+        auto* stream = get_stream<std::fstream>(context, "file");
+        if (!stream)
+            return std::nullopt;
 
-            stream.close();
+        stream->close();
 
-            return {};
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Reference();
     }
 
-    Reference file_get_current_directory(FunctionContext& /*context*/) {
+    std::optional<Reference> file_get_current_directory(FunctionContext& /*context*/) {
         try {
             return Data(GC::new_object(std::filesystem::current_path().string()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_set_current_directory(FunctionContext& context) {
-        try {
-            auto path = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_set_current_directory(FunctionContext& context) {
+        auto path = get_path(context, "path");
+        if (!path)
+            return std::nullopt;
 
-            std::filesystem::current_path(path);
+        try {
+            std::filesystem::current_path(*path);
 
-            return {};
+            return Reference();
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_exists(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_exists(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
-            return Data(std::filesystem::exists(p));
+        try {
+            return Data(std::filesystem::exists(*p));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_size(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_size(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
-            return Data(static_cast<OV_INT>(std::filesystem::file_size(p)));
+        try {
+            return Data(static_cast<OV_INT>(std::filesystem::file_size(*p)));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_is_empty(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_is_empty(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
-            return Data(std::filesystem::is_empty(p));
+        try {
+            return Data(std::filesystem::is_empty(*p));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_is_directory(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_is_directory(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
-            return Data(std::filesystem::is_directory(p));
+        try {
+            return Data(std::filesystem::is_directory(*p));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_create_directories(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_create_directories(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
-            return Data(std::filesystem::create_directory(p));
+        try {
+            return Data(std::filesystem::create_directory(*p));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -319,118 +310,117 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("to")
         }
     ));
-    Reference file_copy(FunctionContext& context) {
-        try {
-            std::filesystem::path from = context["from"].to_data(context).get<ObjectPtr>()->to_string();
-            std::filesystem::path to = context["to"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_copy(FunctionContext& context) {
+        auto from = get_path(context, "from");
+        auto to = get_path(context, "to");
+        if (!from || !to)
+            return std::nullopt;
 
-            std::filesystem::copy(from, to);
+        try {
+            std::filesystem::copy(*from, *to);
 
-            return {};
+            return Reference();
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
-    Reference file_rename(FunctionContext& context) {
-        try {
-            std::filesystem::path from = context["from"].to_data(context).get<ObjectPtr>()->to_string();
-            std::filesystem::path to = context["to"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_rename(FunctionContext& context) {
+        auto from = get_path(context, "from");
+        auto to = get_path(context, "to");
+        if (!from || !to)
+            return std::nullopt;
 
-            std::filesystem::rename(from, to);
+        try {
+            std::filesystem::rename(*from, *to);
 
-            return {};
+            return Reference();
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_delete(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_delete(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
-            return Data(static_cast<OV_INT>(std::filesystem::remove_all(p)));
+        try {
+            return Data(static_cast<OV_INT>(std::filesystem::remove_all(*p)));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_children(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_children(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
 
+        try {
             auto obj = GC::new_object();
-            for (auto const& child : std::filesystem::directory_iterator(p))
-                obj->array.emplace_back(GC::new_object(child.path().string()));
+            for (auto const& child : std::filesystem::directory_iterator(*p))
+                obj->array.push_back(Data(GC::new_object(child.path().string())));
 
             return Data(obj);
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_concatenate(FunctionContext& context) {
-        try {
-            std::filesystem::path from = context["from"].to_data(context).get<ObjectPtr>()->to_string();
-            std::filesystem::path to = context["to"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> file_concatenate(FunctionContext& context) {
+        auto from = get_path(context, "from");
+        auto to = get_path(context, "to");
+        if (!from || !to)
+            return std::nullopt;
 
-            return Data(GC::new_object((from / to).string()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(GC::new_object((*from / *to).string()));
     }
 
-    Reference file_parent(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-            return Data(GC::new_object(p.parent_path().string()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> file_parent(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
+        return Data(GC::new_object(p->parent_path().string()));
     }
 
-    Reference file_absolute(FunctionContext& context) {
+    std::optional<Reference> file_absolute(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
+
         try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-            return Data(GC::new_object(std::filesystem::weakly_canonical(p).string()));
+            return Data(GC::new_object(std::filesystem::weakly_canonical(*p).string()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
-    Reference file_root(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-            return Data(GC::new_object(p.root_path().string()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> file_root(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
+        return Data(GC::new_object(p->root_path().string()));
     }
 
-    Reference file_filename(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-            return Data(GC::new_object(p.filename().string()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> file_filename(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
+        return Data(GC::new_object(p->filename().string()));
     }
 
-    Reference file_extension(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-            return Data(GC::new_object(p.extension().string()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> file_extension(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
+        return Data(GC::new_object(p->extension().string()));
     }
 
-    Reference file_filename_without_extension(FunctionContext& context) {
-        try {
-            std::filesystem::path p = context["path"].to_data(context).get<ObjectPtr>()->to_string();
-            return Data(GC::new_object(p.stem().string()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> file_filename_without_extension(FunctionContext& context) {
+        auto p = get_path(context, "path");
+        if (!p)
+            return std::nullopt;
+        return Data(GC::new_object(p->stem().string()));
     }
 
 
@@ -441,13 +431,7 @@ namespace Interpreter::SystemFunctions::System {
 
     auto const TCPsocket_is_args = std::make_shared<Parser::Symbol>("socket");
     Reference TCPsocket_is(FunctionContext& context) {
-        try {
-            context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPSocket>();
-
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+        return Data(get_native<TCPSocket>(context, "socket") != nullptr);
     }
 
     auto const TCPsocket_connect_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -456,14 +440,16 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("port")
         }
     ));
-    Reference TCPsocket_connect(FunctionContext& context) {
-        try {
-            auto address = context["address"].to_data(context).get<ObjectPtr>()->to_string();
-            auto port = context["port"].to_data(context).get<OV_INT>();
+    std::optional<Reference> TCPsocket_connect(FunctionContext& context) {
+        auto address = get_arg<std::string>(context, context["address"].to_data(context));
+        auto port = get_arg<OV_INT>(context, context["port"].to_data(context));
+        if (!address || !port)
+            return std::nullopt;
 
+        try {
             auto socket = std::make_unique<TCPSocket>(ioc);
             boost::system::error_code ec;
-            socket->connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(address), port), ec);
+            socket->connect(boost::asio::ip::tcp::endpoint(boost::asio::ip::address::from_string(*address), *port), ec);
 
             if (!ec) {
                 auto object = GC::new_object();
@@ -472,7 +458,7 @@ namespace Interpreter::SystemFunctions::System {
             } else
                 return Data(static_cast<OV_INT>(ec.value()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -482,25 +468,24 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("size")
         }
     ));
-    Reference TCPsocket_receive(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPSocket>();
-            auto size = context["size"].to_data(context).get<OV_INT>();
+    std::optional<Reference> TCPsocket_receive(FunctionContext& context) {
+        auto* socket = get_native<TCPSocket>(context, "socket");
+        auto size = get_arg<OV_INT>(context, context["size"].to_data(context));
+        if (!socket || !size || *size < 0)
+            return std::nullopt;
 
+        try {
             boost::system::error_code ec;
-            std::vector<char> buffer(size);
-            auto received = socket.receive(boost::asio::buffer(buffer), {}, ec);
+            std::vector<char> buffer(static_cast<size_t>(*size));
+            auto received = socket->receive(boost::asio::buffer(buffer), {}, ec);
 
             if (!ec) {
-                auto object = GC::new_object();
-                object->array.reserve(received);
-                for (size_t i = 0; i < received; ++i)
-                    object->array.emplace_back(buffer[i]);
+                auto object = GC::new_object(std::string(buffer.data(), received));
                 return Data(object);
             } else
                 return Data(static_cast<OV_INT>(ec.value()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -510,35 +495,31 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("data")
         }
     ));
-    Reference TCPsocket_send(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPSocket>();
-            auto data = context["data"].to_data(context).get<ObjectPtr>();
+    std::optional<Reference> TCPsocket_send(FunctionContext& context) {
+        auto* socket = get_native<TCPSocket>(context, "socket");
+        auto buffer = get_arg<std::string>(context, context["data"].to_data(context));
+        if (!socket || !buffer)
+            return std::nullopt;
 
-            std::vector<char> buffer(data->array.size());
-            for (size_t i = 0; i < data->array.size(); ++i)
-                buffer[i] = data->array[i].get<char>();
+        boost::system::error_code ec;
+        socket->send(boost::asio::buffer(*buffer), {}, ec);
 
-            boost::system::error_code ec;
-            socket.send(boost::asio::buffer(buffer), {}, ec);
-
-            if (!ec)
-                return {};
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     auto const TCPsocket_get_blocking_args = std::make_shared<Parser::Symbol>("socket");
-    Reference TCPsocket_get_blocking(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPSocket>();
+    std::optional<Reference> TCPsocket_get_blocking(FunctionContext& context) {
+        auto* socket = get_native<TCPSocket>(context, "socket");
+        if (!socket)
+            return std::nullopt;
 
-            return Data(!socket.non_blocking());
+        try {
+            return Data(!socket->non_blocking());
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -548,38 +529,34 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("value")
         }
     ));
-    Reference TCPsocket_set_blocking(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPSocket>();
-            auto value = context["value"].to_data(context).get<bool>();
+    std::optional<Reference> TCPsocket_set_blocking(FunctionContext& context) {
+        auto* socket = get_native<TCPSocket>(context, "socket");
+        auto value = get_arg<bool>(context, context["value"].to_data(context));
+        if (!socket || !value)
+            return std::nullopt;
 
-            boost::system::error_code ec;
-            socket.non_blocking(!value, ec);
+        boost::system::error_code ec;
+        socket->non_blocking(!*value, ec);
 
-            if (!ec)
-                return {};
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     auto const TCPsocket_close_args = std::make_shared<Parser::Symbol>("socket");
-    Reference TCPsocket_close(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPSocket>();
+    std::optional<Reference> TCPsocket_close(FunctionContext& context) {
+        auto* socket = get_native<TCPSocket>(context, "socket");
+        if (!socket)
+            return std::nullopt;
 
-            boost::system::error_code ec;
-            socket.close(ec);
+        boost::system::error_code ec;
+        socket->close(ec);
 
-            if (!ec)
-                return {};
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
 
@@ -587,13 +564,7 @@ namespace Interpreter::SystemFunctions::System {
 
     auto const TCPacceptor_is_args = std::make_shared<Parser::Symbol>("acceptor");
     Reference TCPacceptor_is(FunctionContext& context) {
-        try {
-            context["acceptor"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPAcceptor>();
-
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+        return Data(get_native<TCPAcceptor>(context, "acceptor") != nullptr);
     }
 
     auto const TCPacceptor_bind_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -602,14 +573,16 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("port")
         }
     ));
-    Reference TCPacceptor_bind(FunctionContext& context) {
-        try {
-            auto address = context["address"].to_data(context).get<ObjectPtr>()->to_string();
-            auto port = context["port"].to_data(context).get<OV_INT>();
+    std::optional<Reference> TCPacceptor_bind(FunctionContext& context) {
+        auto address = get_arg<std::string>(context, context["address"].to_data(context));
+        auto port = get_arg<OV_INT>(context, context["port"].to_data(context));
+        if (!address || !port)
+            return std::nullopt;
 
+        try {
             auto acceptor = std::make_unique<TCPAcceptor>(ioc);
             boost::system::error_code ec;
-            boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), port);
+            boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), *port);
             acceptor->open(endpoint.protocol(), ec);
             acceptor->bind(endpoint, ec);
             acceptor->listen();
@@ -621,38 +594,38 @@ namespace Interpreter::SystemFunctions::System {
             } else
                 return Data(static_cast<OV_INT>(ec.value()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
     auto const TCPacceptor_accept_args = std::make_shared<Parser::Symbol>("acceptor");
-    Reference TCPacceptor_accept(FunctionContext& context) {
-        try {
-            auto& acceptor = context["acceptor"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPAcceptor>();
+    std::optional<Reference> TCPacceptor_accept(FunctionContext& context) {
+        auto* acceptor = get_native<TCPAcceptor>(context, "acceptor");
+        if (!acceptor)
+            return std::nullopt;
 
-            auto socket = std::make_unique<TCPSocket>(ioc);
-            boost::system::error_code ec;
-            acceptor.accept(*socket, ec);
+        auto socket = std::make_unique<TCPSocket>(ioc);
+        boost::system::error_code ec;
+        acceptor->accept(*socket, ec);
 
-            if (!ec) {
-                auto object = GC::new_object();
-                object->c_obj.set(std::move(socket));
-                return Data(object);
-            } else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec) {
+            auto object = GC::new_object();
+            object->c_obj.set(std::move(socket));
+            return Data(object);
+        } else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     auto const TCPacceptor_get_blocking_args = std::make_shared<Parser::Symbol>("acceptor");
-    Reference TCPacceptor_get_blocking(FunctionContext& context) {
-        try {
-            auto& acceptor = context["acceptor"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPAcceptor>();
+    std::optional<Reference> TCPacceptor_get_blocking(FunctionContext& context) {
+        auto* acceptor = get_native<TCPAcceptor>(context, "acceptor");
+        if (!acceptor)
+            return std::nullopt;
 
-            return Data(!acceptor.non_blocking());
+        try {
+            return Data(!acceptor->non_blocking());
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -662,76 +635,62 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("value")
         }
     ));
-    Reference TCPacceptor_set_blocking(FunctionContext& context) {
-        try {
-            auto& acceptor = context["acceptor"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPAcceptor>();
-            auto value = context["value"].to_data(context).get<bool>();
+    std::optional<Reference> TCPacceptor_set_blocking(FunctionContext& context) {
+        auto* acceptor = get_native<TCPAcceptor>(context, "acceptor");
+        auto value = get_arg<bool>(context, context["value"].to_data(context));
+        if (!acceptor || !value)
+            return std::nullopt;
 
-            boost::system::error_code ec;
-            acceptor.non_blocking(!value, ec);
+        boost::system::error_code ec;
+        acceptor->non_blocking(!*value, ec);
 
-            if (!ec)
-                return Reference();
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     auto const TCPacceptor_close_args = std::make_shared<Parser::Symbol>("acceptor");
-    Reference TCPacceptor_close(FunctionContext& context) {
-        try {
-            auto& acceptor = context["acceptor"].to_data(context).get<ObjectPtr>()->c_obj.get<TCPAcceptor>();
+    std::optional<Reference> TCPacceptor_close(FunctionContext& context) {
+        auto* acceptor = get_native<TCPAcceptor>(context, "acceptor");
+        if (!acceptor)
+            return std::nullopt;
 
-            boost::system::error_code ec;
-            acceptor.close(ec);
+        boost::system::error_code ec;
+        acceptor->close(ec);
 
-            if (!ec)
-                return Reference();
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     using UDPSocket = boost::asio::ip::udp::socket;
 
     auto const UDPsocket_is_args = std::make_shared<Parser::Symbol>("socket");
     Reference UDPsocket_is(FunctionContext& context) {
-        try {
-            context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<UDPSocket>();
-
-            return Data(true);
-        } catch (std::exception const&) {
-            return Data(false);
-        }
+        return Data(get_native<UDPSocket>(context, "socket") != nullptr);
     }
 
     auto const UDPsocket_open_args = std::make_shared<Parser::Symbol>("protocol");
-    Reference UDPsocket_open(FunctionContext& context) {
-        try {
-            auto protocol = context["protocol"].to_data(context).get<OV_INT>();
-
-            auto socket = std::make_unique<UDPSocket>(ioc);
-            boost::system::error_code ec;
-            if (protocol == 4)
-                socket->open(boost::asio::ip::udp::v4(), ec);
-            else if (protocol == 6)
-                socket->open(boost::asio::ip::udp::v6(), ec);
-            else
-                throw FunctionArgumentsError();
-
-            if (!ec) {
-                auto object = GC::new_object();
-                object->c_obj.set(std::move(socket));
-                return Data(object);
-            } else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> UDPsocket_open(FunctionContext& context) {
+        auto protocol = get_arg<OV_INT>(context, context["protocol"].to_data(context));
+        if (!protocol || (*protocol != 4 && *protocol != 6))
+            return std::nullopt;
+
+        auto socket = std::make_unique<UDPSocket>(ioc);
+        boost::system::error_code ec;
+        if (*protocol == 4)
+            socket->open(boost::asio::ip::udp::v4(), ec);
+        else
+            socket->open(boost::asio::ip::udp::v6(), ec);
+
+        if (!ec) {
+            auto object = GC::new_object();
+            object->c_obj.set(std::move(socket));
+            return Data(object);
+        } else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     auto const UDPsocket_bind_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -740,14 +699,16 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("port")
         }
     ));
-    Reference UDPsocket_bind(FunctionContext& context) {
-        try {
-            auto address = context["address"].to_data(context).get<ObjectPtr>()->to_string();
-            auto port = context["port"].to_data(context).get<OV_INT>();
+    std::optional<Reference> UDPsocket_bind(FunctionContext& context) {
+        auto address = get_arg<std::string>(context, context["address"].to_data(context));
+        auto port = get_arg<OV_INT>(context, context["port"].to_data(context));
+        if (!address || !port)
+            return std::nullopt;
 
+        try {
             auto socket = std::make_unique<UDPSocket>(ioc);
             boost::system::error_code ec;
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address), port);
+            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(*address), *port);
             socket->open(endpoint.protocol(), ec);
             socket->bind(endpoint, ec);
 
@@ -758,7 +719,7 @@ namespace Interpreter::SystemFunctions::System {
             } else
                 return Data(static_cast<OV_INT>(ec.value()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -768,21 +729,20 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("size")
         }
     ));
-    Reference UDPsocket_receive_from(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<UDPSocket>();
-            auto size = context["size"].to_data(context).get<OV_INT>();
+    std::optional<Reference> UDPsocket_receive_from(FunctionContext& context) {
+        auto* socket = get_native<UDPSocket>(context, "socket");
+        auto size = get_arg<OV_INT>(context, context["size"].to_data(context));
+        if (!socket || !size || *size < 0)
+            return std::nullopt;
 
+        try {
             boost::system::error_code ec;
-            std::vector<char> buffer(size);
+            std::vector<char> buffer(static_cast<size_t>(*size));
             boost::asio::ip::udp::endpoint endpoint;
-            auto received = socket.receive_from(boost::asio::buffer(buffer), endpoint, {}, ec);
+            auto received = socket->receive_from(boost::asio::buffer(buffer), endpoint, {}, ec);
 
             if (!ec) {
-                auto object = GC::new_object();
-                object->array.reserve(received);
-                for (size_t i = 0; i < received; ++i)
-                    object->array.emplace_back(buffer[i]);
+                auto object = GC::new_object(std::string(buffer.data(), received));
                 return TupleReference{
                     TupleReference{Data(GC::new_object(Object(endpoint.address().to_string()))), Data(static_cast<OV_INT>(endpoint.port()))},
                     Data(object)
@@ -790,7 +750,7 @@ namespace Interpreter::SystemFunctions::System {
             } else
                 return Data(static_cast<OV_INT>(ec.value()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -806,38 +766,38 @@ namespace Interpreter::SystemFunctions::System {
             ))
         }
     ));
-    Reference UDPsocket_send_to(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<UDPSocket>();
-            auto data = context["data"].to_data(context).get<ObjectPtr>();
-            auto address = context["address"].to_data(context).get<ObjectPtr>()->to_string();
-            auto port = context["port"].to_data(context).get<OV_INT>();
-
-            std::vector<char> buffer(data->array.size());
-            for (size_t i = 0; i < data->array.size(); ++i)
-                buffer[i] = data->array[i].get<char>();
+    std::optional<Reference> UDPsocket_send_to(FunctionContext& context) {
+        auto* socket = get_native<UDPSocket>(context, "socket");
+        auto buffer = get_arg<std::string>(context, context["data"].to_data(context));
+        auto address = get_arg<std::string>(context, context["address"].to_data(context));
+        auto port = get_arg<OV_INT>(context, context["port"].to_data(context));
+        if (!socket || !buffer || !address || !port)
+            return std::nullopt;
 
+        try {
             boost::system::error_code ec;
-            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(address), port);
-            socket.send_to(boost::asio::buffer(buffer), endpoint, {}, ec);
+            boost::asio::ip::udp::endpoint endpoint(boost::asio::ip::address::from_string(*address), *port);
+            socket->send_to(boost::asio::buffer(*buffer), endpoint, {}, ec);
 
             if (!ec)
-                return {};
+                return Reference();
             else
                 return Data(static_cast<OV_INT>(ec.value()));
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
     auto const UDPsocket_get_blocking_args = std::make_shared<Parser::Symbol>("socket");
-    Reference UDPsocket_get_blocking(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<UDPSocket>();
+    std::optional<Reference> UDPsocket_get_blocking(FunctionContext& context) {
+        auto* socket = get_native<UDPSocket>(context, "socket");
+        if (!socket)
+            return std::nullopt;
 
-            return Data(!socket.non_blocking());
+        try {
+            return Data(!socket->non_blocking());
         } catch (std::exception const&) {
-            throw FunctionArgumentsError();
+            return std::nullopt;
         }
     }
 
@@ -847,38 +807,34 @@ namespace Interpreter::SystemFunctions::System {
             std::make_shared<Parser::Symbol>("value")
         }
     ));
-    Reference UDPsocket_set_blocking(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<UDPSocket>();
-            auto value = context["value"].to_data(context).get<bool>();
+    std::optional<Reference> UDPsocket_set_blocking(FunctionContext& context) {
+        auto* socket = get_native<UDPSocket>(context, "socket");
+        auto value = get_arg<bool>(context, context["value"].to_data(context));
+        if (!socket || !value)
+            return std::nullopt;
 
-            boost::system::error_code ec;
-            socket.non_blocking(!value, ec);
+        boost::system::error_code ec;
+        socket->non_blocking(!*value, ec);
 
-            if (!ec)
-                return {};
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
     auto const UDPsocket_close_args = std::make_shared<Parser::Symbol>("socket");
-    Reference UDPsocket_close(FunctionContext& context) {
-        try {
-            auto& socket = context["socket"].to_data(context).get<ObjectPtr>()->c_obj.get<UDPSocket>();
+    std::optional<Reference> UDPsocket_close(FunctionContext& context) {
+        auto* socket = get_native<UDPSocket>(context, "socket");
+        if (!socket)
+            return std::nullopt;
 
-            boost::system::error_code ec;
-            socket.close(ec);
+        boost::system::error_code ec;
+        socket->close(ec);
 
-            if (!ec)
-                return {};
-            else
-                return Data(static_cast<OV_INT>(ec.value()));
-        } catch (std::exception const&) {
-            throw FunctionArgumentsError();
-        }
+        if (!ec)
+            return Reference();
+        else
+            return Data(static_cast<OV_INT>(ec.value()));
     }
 
 
@@ -901,78 +857,58 @@ namespace Interpreter::SystemFunctions::System {
 
     auto const thread_is_args = std::make_shared<Parser::Symbol>("thread");
     Reference thread_is(FunctionContext& context) {
-        try {
-            context["thread"].to_data(context).get<ObjectPtr>()->c_obj.get<std::jthread>();
-
-            return Data(true);
-        } catch (std::bad_any_cast const&) {
-            return Data(false);
-        } catch (Data::BadAccess const&) {
-            return Data(false);
-        }
+        return Data(get_native<std::jthread>(context, "thread") != nullptr);
     }
 
     auto const thread_create_args = std::make_shared<Parser::Symbol>("function");
-    Reference thread_create(FunctionContext& context) {
-        try {
-            auto function = context["function"].to_data(context).get<ObjectPtr>();
+    std::optional<Reference> thread_create(FunctionContext& context) {
+        auto function = get_arg<ObjectPtr>(context, context["function"].to_data(context));
+        if (!function)
+            return std::nullopt;
 
-            auto& global = context.get_global();
-            auto caller = context.caller;
+        auto& global = context.get_global();
+        auto caller = context.caller;
 
-            auto obj = GC::new_object();
-            obj->c_obj.set(std::make_unique<std::jthread>([&global, caller, function]() {
-                try {
-                    Interpreter::call_function(global, caller, Data(function), std::make_shared<Parser::Tuple>());
-                } catch (Interpreter::Exception const& ex) {
-                    ex.print_stack_trace(global);
-                }
-            }));
-            return Data(obj);
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        auto obj = GC::new_object();
+        obj->c_obj.set(std::make_unique<std::jthread>([&global, caller, function = *function, guard = GC::ThreadGuard()]() {
+            try {
+                Interpreter::call_function(global, caller, Data(function), std::make_shared<Parser::Tuple>());
+            } catch (Interpreter::Exception const& ex) {
+                ex.print_stack_trace(global);
+            }
+        }));
+        return Data(obj);
     }
 
     auto const thread_join_args = std::make_shared<Parser::Symbol>("thread");
-    Reference thread_join(FunctionContext& context) {
-        try {
-            auto& thread = context["thread"].to_data(context).get<ObjectPtr>()->c_obj.get<std::jthread>();
-            thread.join();
-
-            return {};
-        } catch (std::bad_any_cast const&) {
-            throw FunctionArgumentsError();
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> thread_join(FunctionContext& context) {
+        auto* thread = get_native<std::jthread>(context, "thread");
+        if (!thread)
+            return std::nullopt;
+
+        thread->join();
+
+        return Reference();
     }
 
     auto const thread_detach_args = std::make_shared<Parser::Symbol>("thread");
-    Reference thread_detach(FunctionContext& context) {
-        try {
-            auto& thread = context["thread"].to_data(context).get<ObjectPtr>()->c_obj.get<std::jthread>();
-            thread.detach();
-
-            return {};
-        } catch (std::bad_any_cast const&) {
-            throw FunctionArgumentsError();
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> thread_detach(FunctionContext& context) {
+        auto* thread = get_native<std::jthread>(context, "thread");
+        if (!thread)
+            return std::nullopt;
+
+        thread->detach();
+
+        return Reference();
     }
 
     auto const thread_get_id_args = std::make_shared<Parser::Symbol>("thread");
-    Reference thread_get_id(FunctionContext& context) {
-        try {
-            auto& thread = context["thread"].to_data(context).get<ObjectPtr>()->c_obj.get<std::jthread>();
+    std::optional<Reference> thread_get_id(FunctionContext& context) {
+        auto* thread = get_native<std::jthread>(context, "thread");
+        if (!thread)
+            return std::nullopt;
 
-            return Data(static_cast<OV_INT>(std::hash<std::thread::id>{}(thread.get_id())));
-        } catch (std::bad_any_cast const&) {
-            throw FunctionArgumentsError();
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(static_cast<OV_INT>(std::hash<std::thread::id>{}(thread->get_id())));
     }
 
     auto const thread_current_id_args = std::make_shared<Parser::Tuple>();
@@ -981,20 +917,17 @@ namespace Interpreter::SystemFunctions::System {
     }
 
     auto const thread_sleep_args = std::make_shared<Parser::Symbol>("time");
-    Reference thread_sleep(FunctionContext& context) {
+    std::optional<Reference> thread_sleep(FunctionContext& context) {
         auto time = context["time"].to_data(context);
 
-        try {
-            std::this_thread::sleep_for(std::chrono::duration<double>(time.get<OV_INT>()));
-            return {};
-        } catch (Data::BadAccess const&) {
-            try {
-                std::this_thread::sleep_for(std::chrono::duration<double>(time.get<OV_FLOAT>()));
-                return {};
-            } catch (Data::BadAccess const&) {
-                throw FunctionArgumentsError();
-            }
-        }
+        if (auto const* i = get_if<OV_INT>(&time))
+            std::this_thread::sleep_for(std::chrono::duration<double>(*i));
+        else if (auto const* f = get_if<OV_FLOAT>(&time))
+            std::this_thread::sleep_for(std::chrono::duration<double>(*f));
+        else
+            return std::nullopt;
+
+        return Reference();
     }
 
     auto const thread_hardware_concurrency_args = std::make_shared<Parser::Tuple>();
@@ -1005,58 +938,43 @@ namespace Interpreter::SystemFunctions::System {
 
     auto const mutex_is_args = std::make_shared<Parser::Symbol>("mutex");
     Reference mutex_is(FunctionContext& context) {
-        try {
-            context["mutex"].to_data(context).get<ObjectPtr>()->c_obj.get<std::mutex>();
-
-            return Data(true);
-        } catch (std::bad_any_cast const&) {
-            return Data(false);
-        } catch (Data::BadAccess const&) {
-            return Data(false);
-        }
+        return Data(get_native<std::mutex>(context, "mutex") != nullptr);
     }
 
     auto const mutex_create_args = std::make_shared<Parser::Tuple>();
     Reference mutex_create(FunctionContext&  /*context*/) {
-        try {
-            auto obj = GC::new_object();
-            obj->c_obj.set(std::make_unique<std::mutex>());
-            return Data(obj);
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        auto obj = GC::new_object();
+        obj->c_obj.set(std::make_unique<std::mutex>());
+        return Data(obj);
     }
 
     auto const mutex_lock_args = std::make_shared<Parser::Symbol>("mutex");
-    Reference mutex_lock(FunctionContext& context) {
-        try {
-            auto& mutex = context["mutex"].to_data(context).get<ObjectPtr>()->c_obj.get<std::mutex>();
-            mutex.lock();
-            return {};
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> mutex_lock(FunctionContext& context) {
+        auto* mutex = get_native<std::mutex>(context, "mutex");
+        if (!mutex)
+            return std::nullopt;
+
+        mutex->lock();
+        return Reference();
     }
 
     auto const mutex_try_lock_args = std::make_shared<Parser::Symbol>("mutex");
-    Reference mutex_try_lock(FunctionContext& context) {
-        try {
-            auto& mutex = context["mutex"].to_data(context).get<ObjectPtr>()->c_obj.get<std::mutex>();
-            return Data(mutex.try_lock());
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> mutex_try_lock(FunctionContext& context) {
+        auto* mutex = get_native<std::mutex>(context, "mutex");
+        if (!mutex)
+            return std::nullopt;
+
+        return Data(mutex->try_lock());
     }
 
     auto const mutex_unlock_args = std::make_shared<Parser::Symbol>("mutex");
-    Reference mutex_unlock(FunctionContext& context) {
-        try {
-            auto& mutex = context["mutex"].to_data(context).get<ObjectPtr>()->c_obj.get<std::mutex>();
-            mutex.unlock();
-            return {};
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+    std::optional<Reference> mutex_unlock(FunctionContext& context) {
+        auto* mutex = get_native<std::mutex>(context, "mutex");
+        if (!mutex)
+            return std::nullopt;
+
+        mutex->unlock();
+        return Reference();
     }
 
 
@@ -1066,6 +984,57 @@ namespace Interpreter::SystemFunctions::System {
         return {};
     }
 
+    auto const GC_statistics_args = std::make_shared<Parser::Tuple>();
+    Reference GC_statistics(FunctionContext& /*context*/) {
+        auto statistics = GC::new_object();
+        for (auto const& arena : GC::get_statistics()) {
+            auto size_classes = GC::new_object();
+            for (auto const& size_class : arena.size_classes) {
+                auto object = GC::new_object();
+                object->properties["block_size"] = Data(static_cast<OV_INT>(size_class.block_size));
+                object->properties["slabs"] = Data(static_cast<OV_INT>(size_class.slabs));
+                object->properties["live"] = Data(static_cast<OV_INT>(size_class.live));
+                object->properties["allocations"] = Data(static_cast<OV_INT>(size_class.allocations));
+                size_classes->array.push_back(Data(object));
+            }
+
+            auto object = GC::new_object();
+            object->properties["slabs"] = Data(static_cast<OV_INT>(arena.slabs));
+            object->properties["live"] = Data(static_cast<OV_INT>(arena.live));
+            object->properties["peak"] = Data(static_cast<OV_INT>(arena.peak));
+            object->properties["allocations"] = Data(static_cast<OV_INT>(arena.allocations));
+            object->properties["size_classes"] = Data(size_classes);
+            statistics->properties[arena.name] = Data(object);
+        }
+        return Data(statistics);
+    }
+
+    /**
+     * Gets the resident set size of the process.
+     * @return the size in bytes, or zero if it is not available.
+    */
+    OV_INT get_resident_set_size() {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        size_t size = 0;
+        size_t resident = 0;
+        if (statm >> size >> resident)
+            return static_cast<OV_INT>(resident * static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+#endif
+        return 0;
+    }
+
+    auto const stats_args = std::make_shared<Parser::Tuple>();
+    Reference stats(FunctionContext& /*context*/) {
+        auto object = GC::new_object();
+        auto const counters = Counters::get();
+        for (size_t i = 0; i < Counters::size; ++i)
+            object->properties[std::string(Counters::get_name(static_cast<Counters::Counter>(i)))] = Data(static_cast<OV_INT>(counters[i]));
+        object->properties["rss"] = Data(get_resident_set_size());
+        object->properties["cpu_time"] = Data(static_cast<OV_FLOAT>(std::clock()) / CLOCKS_PER_SEC);
+        return Data(object);
+    }
+
 
     void init(GlobalContext& context) {
         auto& s = context.get_global().system;
@@ -1152,6 +1121,8 @@ namespace Interpreter::SystemFunctions::System {
         add_function(s.get_property("mutex_unlock"), mutex_unlock_args, mutex_unlock);
 
         add_function(s.get_property("GC_collect"), GC_collect_args, GC_collect);
+        add_function(s.get_property("GC_statistics"), GC_statistics_args, GC_statistics);
+        add_function(s.get_property("stats"), stats_args, stats);
 
         get_object(s.get_property("in"))->c_obj.set(std::reference_wrapper<std::ios>(std::cin));
         get_object(s.get_property("out"))->c_obj.set(std::reference_wrapper<std::ios>(std::cout));
@@ -1,3 +1,7 @@
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <variant>
 
 #include "SystemFunction.hpp"
@@ -25,12 +29,21 @@ namespace Interpreter::SystemFunctions {
     namespace Dll {
         void init(GlobalContext&);
     }
+    namespace HashMap {
+        void init(GlobalContext&);
+    }
     namespace Math {
         void init(GlobalContext&);
     }
+    namespace Matrix {
+        void init(GlobalContext&);
+    }
     namespace System {
         void init(GlobalContext&);
     }
+    namespace TreeMap {
+        void init(GlobalContext&);
+    }
     namespace Types {
         void init(GlobalContext&);
     }
@@ -45,6 +58,9 @@ namespace Interpreter::SystemFunctions {
         Dll::init(context);
         Math::init(context);
         System::init(context);
+        HashMap::init(context);
+        TreeMap::init(context);
+        Matrix::init(context);
         Types::init(context);
         UI::init(context);
     }
@@ -60,15 +76,18 @@ namespace Interpreter::SystemFunctions {
                     return data.get<ObjectPtr>();
                 },
                 [](PropertyReference const& property_reference) {
-                    auto& data = property_reference.parent.get<ObjectPtr>()->properties[property_reference.name];
+                    auto& data = property_reference.parent.get<ObjectPtr>()->properties[property_reference];
                     if (data == Data{})
                         data = GC::new_object();
                     return data.get<ObjectPtr>();
                 },
                 [](ArrayReference const& array_reference) {
-                    auto& data = array_reference.array.get<ObjectPtr>()->array[array_reference.i];
-                    if (data == Data{})
+                    auto& array = array_reference.array.get<ObjectPtr>()->array;
+                    auto data = array.get(array_reference.i);
+                    if (data == Data{}) {
                         data = GC::new_object();
+                        array.set(array_reference.i, data);
+                    }
                     return data.get<ObjectPtr>();
                 }
             },
@@ -76,4 +95,21 @@ namespace Interpreter::SystemFunctions {
         );
     }
 
+    std::optional<std::string_view> get_chars(Object const& object, std::string& buffer) {
+        if (object.array.capacity() == 0)
+            return std::nullopt;
+        if (auto const* str = object.array.get_string())
+            return *str;
+
+        buffer.clear();
+        for (size_t i = 0; i < object.array.size(); ++i) {
+            auto d = object.array.get(i);
+            if (auto const* c = get_if<char>(&d))
+                buffer.push_back(*c);
+            else
+                return std::nullopt;
+        }
+        return buffer;
+    }
+
 }
@@ -1,10 +1,12 @@
 #ifndef __INTERPRETER_SYSTEMFUNCTION_HPP__
 #define __INTERPRETER_SYSTEMFUNCTION_HPP__
 
-#include <any>
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -21,57 +23,98 @@ namespace Interpreter::SystemFunctions {
 
     ObjectPtr get_object(IndirectReference const& reference);
 
+    /**
+     * Gets the characters of an object which is an array of characters.
+     * @param object the object.
+     * @param buffer a buffer for the characters of an array which does not store them as bytes.
+     * @return the characters, or nothing if the object is not an array of characters.
+    */
+    std::optional<std::string_view> get_chars(Object const& object, std::string& buffer);
+
+    /**
+     * Converts a data to the argument of a native function.
+     * @param context the context of the call.
+     * @param data the data.
+     * @return the argument, or nothing if the data has not the type of the argument.
+    */
     template<typename Arg>
-    [[nodiscard]] Arg get_arg(FunctionContext& /*context*/, Data const& data) {
-        return data.get<ObjectPtr>()->c_obj.get<Arg>();
+    [[nodiscard]] std::optional<Arg> get_arg(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            if (auto* arg = (*object)->c_obj.get_if<Arg>())
+                return *arg;
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline bool get_arg<bool>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<bool>();
+    [[nodiscard]] inline std::optional<bool> get_arg<bool>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* b = get_if<bool>(&data))
+            return *b;
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline char get_arg<char>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<char>();
+    [[nodiscard]] inline std::optional<char> get_arg<char>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* c = get_if<char>(&data))
+            return *c;
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline OV_INT get_arg<OV_INT>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<OV_INT>();
+    [[nodiscard]] inline std::optional<OV_INT> get_arg<OV_INT>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* i = get_if<OV_INT>(&data))
+            return *i;
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline OV_FLOAT get_arg<OV_FLOAT>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<OV_FLOAT>();
+    [[nodiscard]] inline std::optional<OV_FLOAT> get_arg<OV_FLOAT>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* f = get_if<OV_FLOAT>(&data))
+            return *f;
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline ObjectPtr get_arg<ObjectPtr>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<ObjectPtr>();
+    [[nodiscard]] inline std::optional<ObjectPtr> get_arg<ObjectPtr>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            return *object;
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline std::string get_arg<std::string>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<ObjectPtr>()->to_string();
+    [[nodiscard]] inline std::optional<std::string> get_arg<std::string>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            return (*object)->to_string();
+        return std::nullopt;
     }
     template<>
-    [[nodiscard]] inline Data get_arg<Data>(FunctionContext& /*context*/, Data const& data) {
+    [[nodiscard]] inline std::optional<Data> get_arg<Data>(FunctionContext& /*context*/, Data const& data) {
         return data;
     }
 
+    /**
+     * Gets the native value held by an argument.
+     * @param context the context of the call.
+     * @param symbol the symbol of the argument.
+     * @return the native value, or nullptr if the argument does not hold a value of this type.
+    */
+    template<typename T>
+    [[nodiscard]] T* get_native(FunctionContext& context, std::string const& symbol) {
+        auto data = context[symbol].to_data(context);
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            return (*object)->c_obj.get_if<T>();
+        return nullptr;
+    }
+
     template<size_t I, typename Arg>
-    [[nodiscard]] std::remove_cv_t<std::remove_reference_t<Arg>> get_arg(FunctionContext& context) {
-        try {
-            return get_arg<std::remove_cv_t<std::remove_reference_t<Arg>>>(context, context["arg" + std::to_string(I)].to_data(context));
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        } catch (std::bad_any_cast const&) {
-            throw FunctionArgumentsError();
-        }
+    [[nodiscard]] std::optional<std::remove_cvref_t<Arg>> get_arg(FunctionContext& context) {
+        return get_arg<std::remove_cvref_t<Arg>>(context, context["arg" + std::to_string(I)].to_data(context));
     }
     template<size_t I>
     [[nodiscard]] IndirectReference get_arg(FunctionContext& context) {
         return context["arg" + std::to_string(I)];
     }
 
-    template<size_t... I, typename... Args>
-    [[nodiscard]] Reference eval(Reference(*function)(Args...), FunctionContext& context, std::index_sequence<I...> /*unused*/) {
-        return function(get_arg<I, Args>(context)...);
+    template<size_t... I, typename R, typename... Args>
+    [[nodiscard]] std::optional<Reference> eval(R(*function)(Args...), FunctionContext& context, std::index_sequence<I...> /*unused*/) {
+        std::tuple<std::optional<std::remove_cvref_t<Args>>...> args{ get_arg<I, Args>(context)... };
+        if ((std::get<I>(args) && ...))
+            return function(*std::move(std::get<I>(args))...);
+        else
+            return std::nullopt;
     }
 
     template<size_t... I>
@@ -83,9 +126,9 @@ namespace Interpreter::SystemFunctions {
         return std::make_shared<Parser::Symbol>("arg" + std::to_string(0));
     }
 
-    template<typename... Args>
-    void add_function(IndirectReference const& reference, Reference(*function)(Args...)) {
-        auto pointer = [function](FunctionContext& context) -> Reference {
+    template<typename R, typename... Args>
+    void add_function(IndirectReference const& reference, R(*function)(Args...)) {
+        auto pointer = [function](FunctionContext& context) -> std::optional<Reference> {
             return eval(function, context, std::index_sequence_for<Args...>{});
         };
         auto parameters = get_parameters(std::index_sequence_for<Args...>{});
@@ -95,6 +138,9 @@ namespace Interpreter::SystemFunctions {
     inline void add_function(IndirectReference const& reference, std::shared_ptr<Parser::Expression> parameters, Reference(*function)(FunctionContext&)) {
         get_object(reference)->functions.emplace_front(SystemFunction{ .parameters = std::move(parameters), .pointer = function });
     }
+    inline void add_function(IndirectReference const& reference, std::shared_ptr<Parser::Expression> parameters, std::optional<Reference>(*function)(FunctionContext&)) {
+        get_object(reference)->functions.emplace_front(SystemFunction{ .parameters = std::move(parameters), .pointer = function });
+    }
 
 }
 
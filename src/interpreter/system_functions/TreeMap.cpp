@@ -0,0 +1,605 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "SystemFunction.hpp"
+
+#include "../Interpreter.hpp"
+
+#include "../../parser/Expressions.hpp"
+
+
+namespace Interpreter::SystemFunctions::TreeMap {
+
+    namespace {
+
+        /**
+         * The maximum number of entries of a leaf or of children of an internal node.
+        */
+        constexpr size_t max_count = 64;
+
+        /**
+         * A node of a B+ tree, a leaf holds entries in the order of their keys and an internal node holds subtrees.
+        */
+        struct Node {
+
+            struct Child {
+                std::unique_ptr<Node> node;
+                size_t size;
+                size_t first;
+            };
+
+            bool leaf = true;
+            std::vector<size_t> entries;
+            std::vector<Child> children;
+
+            [[nodiscard]] size_t count() const {
+                return leaf ? entries.size() : children.size();
+            }
+
+            [[nodiscard]] size_t first() const {
+                return leaf ? entries.front() : children.front().first;
+            }
+
+        };
+
+        /**
+         * The index of a tree map, whose keys and values are stored in turn in the array of its object so that the GC sees them.
+         * The leaves give the entries in the order of the keys and the internal nodes know the size and the lowest key of their subtrees.
+         * The nodes which become empty are removed, the under-full nodes are not merged.
+        */
+        struct Tree {
+            std::unique_ptr<Node> root = std::make_unique<Node>();
+            /**
+             * The number of insertions and removals, which tells if a comparator modified the map.
+            */
+            uint64_t modifications = 0;
+            /**
+             * False if the tree does not index the entries yet, as after a snapshot is loaded, since the order of the objects and the comparator may then only be used once the program runs.
+            */
+            bool sorted = true;
+        };
+
+        /**
+         * Gives the rank of the type of a data in the native order of the keys.
+        */
+        int get_type_rank(Data const& data) {
+            if (get_if<bool>(&data))
+                return 0;
+            else if (get_if<OV_INT>(&data) || get_if<OV_FLOAT>(&data))
+                return 1;
+            else if (get_if<char>(&data))
+                return 2;
+            else if (get_if<ObjectPtr>(&data))
+                return 3;
+            else
+                return 4;
+        }
+
+        /**
+         * The native order of the keys: booleans, then numbers, characters and objects.
+         * The arrays of characters are compared by their content and come before the other objects, compared by their identity.
+        */
+        bool native_less(Data const& a, Data const& b) {
+            auto a_rank = get_type_rank(a);
+            auto b_rank = get_type_rank(b);
+            if (a_rank != b_rank)
+                return a_rank < b_rank;
+
+            if (auto const* a_bool = get_if<bool>(&a))
+                return !*a_bool && b.get<bool>();
+            else if (auto const* a_char = get_if<char>(&a))
+                return *a_char < b.get<char>();
+            else if (auto const* a_object = get_if<ObjectPtr>(&a)) {
+                auto const& b_object = b.get<ObjectPtr>();
+                std::string a_buffer;
+                std::string b_buffer;
+                auto a_chars = get_chars(**a_object, a_buffer);
+                auto b_chars = get_chars(*b_object, b_buffer);
+                if (a_chars && b_chars)
+                    return *a_chars < *b_chars;
+                else if (a_chars || b_chars)
+                    return a_chars.has_value();
+                else
+                    return std::less<Object const*>{}(a_object->get(), b_object.get());
+            } else if (auto const* a_int = get_if<OV_INT>(&a)) {
+                if (auto const* b_int = get_if<OV_INT>(&b))
+                    return *a_int < *b_int;
+                else
+                    return static_cast<OV_FLOAT>(*a_int) < b.get<OV_FLOAT>();
+            } else if (auto const* a_float = get_if<OV_FLOAT>(&a)) {
+                if (auto const* b_int = get_if<OV_INT>(&b))
+                    return *a_float < static_cast<OV_FLOAT>(*b_int);
+                else
+                    return *a_float < b.get<OV_FLOAT>();
+            } else
+                return false;
+        }
+
+        using Less = std::function<bool(Data const&, Data const&)>;
+
+        /**
+         * The place of a key in the tree, the path from the root to its leaf and its position in the leaf.
+        */
+        struct Location {
+            std::vector<std::pair<Node*, size_t>> path;
+            Node* leaf;
+            size_t position;
+            size_t rank;
+        };
+
+        /**
+         * The operations on the index of a tree map.
+         * The comparator, which may be a custom function, is only called while searching, the tree is modified once all the comparisons are done.
+         * A comparator which modifies the map makes the operation throw before it reads the modified tree.
+        */
+        class Index {
+
+            FunctionContext& context;
+            Tree& tree;
+            Array& entries;
+            Less less;
+            uint64_t modifications;
+
+            [[nodiscard]] Data key(size_t e) const {
+                return entries.get(2 * e);
+            }
+
+            [[nodiscard]] bool compare(Data const& a, Data const& b) const {
+                auto const result = less(a, b);
+                if (tree.modifications != modifications)
+                    throw Exception(context, context.caller, "the tree map has been modified by its comparator");
+                return result;
+            }
+
+            /**
+             * Gets the child of an internal node which may hold a key, the last one whose lowest key is not greater.
+            */
+            [[nodiscard]] size_t get_child(Node const& node, Data const& k) const {
+                size_t low = 1;
+                size_t high = node.children.size();
+                while (low < high) {
+                    auto middle = (low + high) / 2;
+                    if (compare(k, key(node.children[middle].first)))
+                        high = middle;
+                    else
+                        low = middle + 1;
+                }
+                return low - 1;
+            }
+
+            /**
+             * Gets the position in a leaf of the first entry whose key is not lower, or greater if strict.
+            */
+            [[nodiscard]] size_t get_position(Node const& node, Data const& k, bool strict) const {
+                auto it = strict ?
+                    std::upper_bound(node.entries.begin(), node.entries.end(), k, [this](Data const& k, size_t e) { return compare(k, key(e)); }) :
+                    std::lower_bound(node.entries.begin(), node.entries.end(), k, [this](size_t e, Data const& k) { return compare(key(e), k); });
+                return it - node.entries.begin();
+            }
+
+            static Node::Child split(Node& node) {
+                auto sibling = std::make_unique<Node>();
+                sibling->leaf = node.leaf;
+                size_t size = 0;
+                if (node.leaf) {
+                    auto middle = node.entries.begin() + node.entries.size() / 2;
+                    sibling->entries.assign(middle, node.entries.end());
+                    node.entries.erase(middle, node.entries.end());
+                    size = sibling->entries.size();
+                } else {
+                    auto middle = node.children.begin() + node.children.size() / 2;
+                    sibling->children.assign(std::make_move_iterator(middle), std::make_move_iterator(node.children.end()));
+                    node.children.erase(middle, node.children.end());
+                    for (auto const& child : sibling->children)
+                        size += child.size;
+                }
+                auto first = sibling->first();
+                return { std::move(sibling), size, first };
+            }
+
+            static size_t get_size(Node const& node) {
+                if (node.leaf)
+                    return node.entries.size();
+
+                size_t size = 0;
+                for (auto const& child : node.children)
+                    size += child.size;
+                return size;
+            }
+
+            void erase(Node& node, size_t rank) {
+                if (node.leaf) {
+                    node.entries.erase(node.entries.begin() + rank);
+                } else {
+                    size_t j = 0;
+                    while (rank >= node.children[j].size)
+                        rank -= node.children[j++].size;
+                    auto& child = node.children[j];
+                    erase(*child.node, rank);
+                    child.size -= 1;
+                    if (child.node->count() == 0)
+                        node.children.erase(node.children.begin() + j);
+                    else
+                        child.first = child.node->first();
+                }
+            }
+
+        public:
+
+            Index(FunctionContext& context, Tree& tree, Array& entries, Less less) :
+                context(context), tree(tree), entries(entries), less(std::move(less)), modifications(tree.modifications) {}
+
+            [[nodiscard]] size_t size() const {
+                return entries.size() / 2;
+            }
+
+            /**
+             * Locates the first entry whose key is not lower than a key, or greater if strict.
+            */
+            [[nodiscard]] Location locate(Data const& k, bool strict) const {
+                Location location;
+                location.rank = 0;
+                Node* node = tree.root.get();
+                while (!node->leaf) {
+                    auto j = get_child(*node, k);
+                    for (size_t i = 0; i < j; ++i)
+                        location.rank += node->children[i].size;
+                    location.path.emplace_back(node, j);
+                    node = node->children[j].node.get();
+                }
+                location.leaf = node;
+                location.position = get_position(*node, k, strict);
+                location.rank += location.position;
+                return location;
+            }
+
+            /**
+             * Tells if the entry of a location, located as not lower than a key, has this key.
+            */
+            [[nodiscard]] bool is_found(Location const& location, Data const& k) const {
+                return location.position < location.leaf->entries.size() && !compare(k, key(location.leaf->entries[location.position]));
+            }
+
+            [[nodiscard]] size_t bound(Data const& k, bool strict) const {
+                return locate(k, strict).rank;
+            }
+
+            [[nodiscard]] std::optional<size_t> find(Data const& k) const {
+                auto location = locate(k, false);
+                if (is_found(location, k))
+                    return location.rank;
+                else
+                    return std::nullopt;
+            }
+
+            [[nodiscard]] size_t select(size_t rank) const {
+                Node const* node = tree.root.get();
+                while (!node->leaf) {
+                    size_t j = 0;
+                    while (rank >= node->children[j].size)
+                        rank -= node->children[j++].size;
+                    node = node->children[j].node.get();
+                }
+                return node->entries[rank];
+            }
+
+            /**
+             * Adds an existing entry to the tree, without comparing any key.
+             * @param location the location of the key of the entry, which the tree must not have changed since.
+             * @param e the index of the entry.
+            */
+            void link(Location const& location, size_t e) {
+                ++tree.modifications;
+
+                auto& leaf = *location.leaf;
+                leaf.entries.insert(leaf.entries.begin() + static_cast<std::ptrdiff_t>(location.position), e);
+                auto sibling = leaf.count() > max_count ? std::optional(split(leaf)) : std::nullopt;
+
+                for (auto it = location.path.rbegin(); it != location.path.rend(); ++it) {
+                    auto& [node, j] = *it;
+                    auto& child = node->children[j];
+                    child.size += 1;
+                    child.first = child.node->first();
+                    if (sibling) {
+                        child.size -= sibling->size;
+                        node->children.insert(node->children.begin() + static_cast<std::ptrdiff_t>(j) + 1, std::move(*sibling));
+                    }
+                    sibling = node->count() > max_count ? std::optional(split(*node)) : std::nullopt;
+                }
+
+                if (sibling) {
+                    auto root = std::make_unique<Node>();
+                    root->leaf = false;
+                    auto first = tree.root->first();
+                    auto size = get_size(*tree.root);
+                    root->children.push_back({ std::move(tree.root), size, first });
+                    root->children.push_back(std::move(*sibling));
+                    tree.root = std::move(root);
+                }
+            }
+
+            /**
+             * Adds an entry for a key which is not in the map, without comparing any key.
+             * @param location the location of the key, which the map must not have changed since.
+             * @return the index of the new entry.
+            */
+            size_t insert(Location const& location, Data const& k) {
+                auto e = size();
+                entries.push_back(k);
+                entries.push_back(Data{});
+                link(location, e);
+                return e;
+            }
+
+            /**
+             * Indexes the entries if the tree does not yet, by adding them one by one to an empty tree.
+            */
+            void sort() {
+                if (tree.sorted)
+                    return;
+
+                modifications = ++tree.modifications;
+                try {
+                    tree.root = std::make_unique<Node>();
+                    for (size_t e = 0; e < size(); ++e) {
+                        link(locate(key(e), false), e);
+                        modifications = tree.modifications;
+                    }
+                } catch (...) {
+                    tree.root = std::make_unique<Node>();
+                    tree.sorted = false;
+                    throw;
+                }
+                tree.sorted = true;
+            }
+
+            void erase(size_t rank) {
+                // The entry moved in place of the removed one is located before the tree changes
+                auto e = select(rank);
+                auto last = size() - 1;
+                auto last_rank = e != last ? locate(key(last), false).rank : 0;
+
+                ++tree.modifications;
+                erase(*tree.root, rank);
+                while (!tree.root->leaf && tree.root->children.size() == 1)
+                    tree.root = std::move(tree.root->children.front().node);
+                if (tree.root->count() == 0)
+                    tree.root = std::make_unique<Node>();
+
+                // Moves the last entry in place of the removed one to keep the entries contiguous
+                if (e != last) {
+                    if (last_rank > rank)
+                        --last_rank;
+                    Node* node = tree.root.get();
+                    while (!node->leaf) {
+                        size_t j = 0;
+                        while (last_rank >= node->children[j].size)
+                            last_rank -= node->children[j++].size;
+                        auto& child = node->children[j];
+                        if (child.first == last)
+                            child.first = e;
+                        node = child.node.get();
+                    }
+                    node->entries[last_rank] = e;
+
+                    entries.set(2 * e, key(last));
+                    entries.set(2 * e + 1, entries.get(2 * last + 1));
+                }
+                entries.resize(2 * last);
+            }
+
+        };
+
+        std::optional<Index> get_index(FunctionContext& context, Data const& map) {
+            if (auto const* object = get_if<ObjectPtr>(&map)) {
+                if (auto* tree = (*object)->c_obj.get_if<Tree>()) {
+                    auto compare = (*object)->properties["compare"];
+                    std::optional<Index> index;
+                    if (compare == Data{})
+                        index.emplace(context, *tree, (*object)->array, native_less);
+                    else
+                        index.emplace(context, *tree, (*object)->array, [&context, compare](Data const& a, Data const& b) {
+                            return Interpreter::call_function(context.get_parent(), nullptr, compare, TupleReference{ a, b }).to_data(context).get<bool>();
+                        });
+                    index->sort();
+                    return index;
+                }
+            }
+            return std::nullopt;
+        }
+
+    }
+
+    bool is_tree(Object const& object) {
+        return object.c_obj.get_if<Tree>() != nullptr;
+    }
+
+    void restore_tree(Object& object) {
+        auto tree = std::make_unique<Tree>();
+        tree->sorted = false;
+        object.c_obj.set(std::move(tree));
+    }
+
+    Reference treemap_create() {
+        auto object = GC::new_object();
+        object->c_obj.set(std::make_unique<Tree>());
+        return Data(object);
+    }
+
+    Reference treemap_create_with(Data const& compare) {
+        auto object = GC::new_object();
+        object->c_obj.set(std::make_unique<Tree>());
+        object->properties["compare"] = compare;
+        return Data(object);
+    }
+
+    std::optional<Reference> treemap_size(ObjectPtr const& map) {
+        if (map->c_obj.get_if<Tree>())
+            return Data(static_cast<OV_INT>(map->array.size() / 2));
+        else
+            return std::nullopt;
+    }
+
+    auto const map_key_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
+        {
+            std::make_shared<Parser::Symbol>("map"),
+            std::make_shared<Parser::Symbol>("key")
+        }
+    ));
+    std::optional<Reference> treemap_get(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            if (!index)
+                return std::nullopt;
+
+            auto key = context["key"].to_data(context);
+            auto location = index->locate(key, false);
+            auto e = index->is_found(location, key) ? location.leaf->entries[location.position] : index->insert(location, key);
+            return map.get_at(2 * e + 1);
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Reference> treemap_has(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            if (!index)
+                return std::nullopt;
+
+            return Data(index->find(context["key"].to_data(context)).has_value());
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Reference> treemap_find(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            if (!index)
+                return std::nullopt;
+
+            auto rank = index->find(context["key"].to_data(context));
+            return Data(rank ? static_cast<OV_INT>(*rank) : static_cast<OV_INT>(-1));
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Reference> treemap_remove(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            if (!index)
+                return std::nullopt;
+
+            if (auto rank = index->find(context["key"].to_data(context)))
+                index->erase(*rank);
+            return Data{};
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Reference> treemap_lower_bound(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            if (!index)
+                return std::nullopt;
+
+            return Data(static_cast<OV_INT>(index->bound(context["key"].to_data(context), false)));
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Reference> treemap_upper_bound(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            if (!index)
+                return std::nullopt;
+
+            return Data(static_cast<OV_INT>(index->bound(context["key"].to_data(context), true)));
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+    auto const map_rank_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
+        {
+            std::make_shared<Parser::Symbol>("map"),
+            std::make_shared<Parser::Symbol>("rank")
+        }
+    ));
+    std::optional<Reference> treemap_entry(FunctionContext& context) {
+        auto map = context["map"].to_data(context);
+        auto index = get_index(context, map);
+        auto rank = context["rank"].to_data(context);
+        auto const* r = get_if<OV_INT>(&rank);
+        if (!index || !r || *r < 0 || static_cast<size_t>(*r) >= index->size())
+            return std::nullopt;
+
+        auto e = index->select(*r);
+        return TupleReference{ map.get_at(2 * e), map.get_at(2 * e + 1) };
+    }
+
+    std::optional<Reference> treemap_key(FunctionContext& context) {
+        auto map = context["map"].to_data(context);
+        auto index = get_index(context, map);
+        auto rank = context["rank"].to_data(context);
+        auto const* r = get_if<OV_INT>(&rank);
+        if (!index || !r || *r < 0 || static_cast<size_t>(*r) >= index->size())
+            return std::nullopt;
+
+        return map.get<ObjectPtr>()->array.get(2 * index->select(*r));
+    }
+
+    std::optional<Reference> treemap_remove_entry(FunctionContext& context) {
+        try {
+            auto map = context["map"].to_data(context);
+            auto index = get_index(context, map);
+            auto rank = context["rank"].to_data(context);
+            auto const* r = get_if<OV_INT>(&rank);
+            if (!index || !r || *r < 0 || static_cast<size_t>(*r) >= index->size())
+                return std::nullopt;
+
+            index->erase(*r);
+            return Data{};
+        } catch (Data::BadAccess const&) {
+            return std::nullopt;
+        }
+    }
+
+
+    void init(GlobalContext& context) {
+        auto s = context.get_global().system;
+
+        add_function(s.get_property("treemap_create"), treemap_create_with);
+        add_function(s.get_property("treemap_create"), treemap_create);
+        add_function(s.get_property("treemap_size"), treemap_size);
+        add_function(s.get_property("treemap_get"), map_key_args, treemap_get);
+        add_function(s.get_property("treemap_has"), map_key_args, treemap_has);
+        add_function(s.get_property("treemap_find"), map_key_args, treemap_find);
+        add_function(s.get_property("treemap_remove"), map_key_args, treemap_remove);
+        add_function(s.get_property("treemap_lower_bound"), map_key_args, treemap_lower_bound);
+        add_function(s.get_property("treemap_upper_bound"), map_key_args, treemap_upper_bound);
+        add_function(s.get_property("treemap_entry"), map_rank_args, treemap_entry);
+        add_function(s.get_property("treemap_key"), map_rank_args, treemap_key);
+        add_function(s.get_property("treemap_remove_entry"), map_rank_args, treemap_remove_entry);
+    }
+
+}
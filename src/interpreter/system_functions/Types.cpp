@@ -1,4 +1,5 @@
 #include <memory>
+#include <optional>
 #include <string>
 #include <variant>
 
@@ -15,16 +16,16 @@ namespace Interpreter::SystemFunctions::Types {
 
     auto const constructor_args = std::make_shared<Parser::Symbol>("a");
 
-    Reference char_constructor(FunctionContext& context) {
+    std::optional<Reference> char_constructor(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (a.is<char>())
             return a;
         else
-            throw FunctionArgumentsError();
+            return std::nullopt;
     }
 
-    Reference float_constructor(FunctionContext& context) {
+    std::optional<Reference> float_constructor(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (auto const* a_int = get_if<OV_INT>(&a)) {
@@ -32,10 +33,10 @@ namespace Interpreter::SystemFunctions::Types {
         } else if (a.is<OV_FLOAT>()) {
             return a;
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference int_constructor(FunctionContext& context) {
+    std::optional<Reference> int_constructor(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (a.is<OV_INT>()) {
@@ -43,25 +44,25 @@ namespace Interpreter::SystemFunctions::Types {
         } else if (auto const* a_float = get_if<OV_FLOAT>(&a)) {
             return Data((OV_INT) *a_float);
         }
-        throw FunctionArgumentsError();
+        return std::nullopt;
     }
 
-    Reference bool_constructor(FunctionContext& context) {
+    std::optional<Reference> bool_constructor(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (a.is<bool>())
             return a;
         else
-            throw FunctionArgumentsError();
+            return std::nullopt;
     }
 
-    Reference array_constructor(FunctionContext& context) {
+    std::optional<Reference> array_constructor(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (auto const* obj = get_if<ObjectPtr>(&a); obj && (*obj)->array.capacity() > 0)
             return a;
         else
-            throw FunctionArgumentsError();
+            return std::nullopt;
     }
 
     auto const tuple_constructor_args = std::make_shared<Parser::FunctionCall>(
@@ -77,38 +78,34 @@ namespace Interpreter::SystemFunctions::Types {
             return TupleReference{ tuple };
     }
 
-    Reference function_constructor(FunctionContext& context) {
+    std::optional<Reference> function_constructor(FunctionContext& context) {
         auto a = context["a"].to_data(context);
 
         if (auto const* obj = get_if<ObjectPtr>(&a); obj && !(*obj)->functions.empty())
             return a;
         else
-            throw FunctionArgumentsError();
+            return std::nullopt;
     }
 
 
-    Reference float_parse(FunctionContext& context) {
-        try {
-            auto a = context["a"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> float_parse(FunctionContext& context) {
+        auto const a = get_arg<std::string>(context, context["a"].to_data(context));
+        if (!a)
+            return std::nullopt;
 
-            return Data(static_cast<OV_FLOAT>(std::stod(a)));
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(static_cast<OV_FLOAT>(std::stod(*a)));
     }
 
-    Reference int_parse(FunctionContext& context) {
-        try {
-            auto a = context["a"].to_data(context).get<ObjectPtr>()->to_string();
+    std::optional<Reference> int_parse(FunctionContext& context) {
+        auto const a = get_arg<std::string>(context, context["a"].to_data(context));
+        if (!a)
+            return std::nullopt;
 
-            return Data(static_cast<OV_INT>(std::stoi(a)));
-        } catch (Data::BadAccess const&) {
-            throw FunctionArgumentsError();
-        }
+        return Data(static_cast<OV_INT>(std::stoi(*a)));
     }
 
 
-    bool check_type(Context& context, Data const& data, Data const& type) {
+    std::optional<bool> check_type(Context& context, Data const& data, Data const& type) {
         if (type == context["Char"].to_data(context)) return data.is<char>();
         else if (type == context["Float"].to_data(context)) return data.is<OV_FLOAT>();
         else if (type == context["Int"].to_data(context)) return data.is<OV_INT>();
@@ -123,7 +120,7 @@ namespace Interpreter::SystemFunctions::Types {
                 return !(*obj)->functions.empty();
             else
                 return false;
-        } else throw FunctionArgumentsError();
+        } else return std::nullopt;
     }
 
     auto const is_type_args = std::make_shared<Parser::Tuple>(Parser::Tuple(
@@ -132,11 +129,14 @@ namespace Interpreter::SystemFunctions::Types {
             std::make_shared<Parser::Symbol>("type")
         }
     ));
-    Reference is_type(FunctionContext& context) {
+    std::optional<Reference> is_type(FunctionContext& context) {
         auto data = context["data"].to_data(context);
         auto type = context["type"].to_data(context);
 
-        return Data(check_type(context, data, type));
+        if (auto const result = check_type(context, data, type))
+            return Data(*result);
+        else
+            return std::nullopt;
     }
 
     void init(GlobalContext& context) {
@@ -12,13 +12,19 @@
 
 namespace Interpreter::SystemFunctions {
     template<>
-    inline wxWindow* get_arg<wxWindow*>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<ObjectPtr>()->c_obj.get<wxWeakRef<wxWindow>>().get();
+    inline std::optional<wxWindow*> get_arg<wxWindow*>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            if (auto* window = (*object)->c_obj.get_if<wxWeakRef<wxWindow>>())
+                return window->get();
+        return std::nullopt;
     }
 
     template<>
-    inline wxSizer* get_arg<wxSizer*>(FunctionContext& /*context*/, Data const& data) {
-        return data.get<ObjectPtr>()->c_obj.get<wxSizer*>();
+    inline std::optional<wxSizer*> get_arg<wxSizer*>(FunctionContext& /*context*/, Data const& data) {
+        if (auto const* object = get_if<ObjectPtr>(&data))
+            if (auto* sizer = (*object)->c_obj.get_if<wxSizer*>())
+                return *sizer;
+        return std::nullopt;
     }
 }
 
@@ -31,29 +37,25 @@ namespace Interpreter::SystemFunctions::UI {
 
             EventHandler(wxEventTypeTag<Args> const& type) : type(type) {}
 
-            Reference operator()(FunctionContext& context) {
-                try {
-                    auto* window = context["window"].to_data(context).get<ObjectPtr>()->c_obj.get<wxWeakRef<wxWindow>>().get();
-                    auto callback = context["callback"];
-
-                    auto& global = context.get_global();
-                    auto function_context = std::make_shared<FunctionContext>(global, nullptr);
-                    function_context->add_symbol("callback", callback);
-
-                    window->Bind(type, [function_context](Args&) {
-                        try {
-                            Interpreter::try_call_function(*function_context, nullptr, (*function_context)["callback"], std::make_shared<Parser::Tuple>());
-                        } catch (Interpreter::Exception const& ex) {
-                            ex.print_stack_trace(*function_context);
-                        }
-                    });
-
-                    return Data{};
-                } catch (Data::BadAccess const&) {
-                    throw FunctionArgumentsError();
-                } catch (std::bad_any_cast const&) {
-                    throw FunctionArgumentsError();
-                }
+            std::optional<Reference> operator()(FunctionContext& context) {
+                auto const window = get_arg<wxWindow*>(context, context["window"].to_data(context));
+                if (!window || *window == nullptr)
+                    return std::nullopt;
+                auto callback = context["callback"];
+
+                auto& global = context.get_global();
+                auto function_context = std::make_shared<FunctionContext>(global, nullptr);
+                function_context->add_symbol("callback", callback);
+
+                (*window)->Bind(type, [function_context](Args&) {
+                    try {
+                        Interpreter::try_call_function(*function_context, nullptr, (*function_context)["callback"], std::make_shared<Parser::Tuple>());
+                    } catch (Interpreter::Exception const& ex) {
+                        ex.print_stack_trace(*function_context);
+                    }
+                });
+
+                return Data{};
             }
         };
 
@@ -7,6 +7,7 @@
 #include <future>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <sstream>
@@ -18,6 +19,8 @@
 #include <boost/dll.hpp>
 
 #include "interpreter/Interpreter.hpp"
+#include "interpreter/Profiler.hpp"
+#include "interpreter/Snapshot.hpp"
 
 #include "parser/Expressions.hpp"
 #include "parser/Standard.hpp"
@@ -56,6 +59,14 @@ bool get_line(std::string& line) {
 #endif
 
 
+/**
+ * The snapshot files a process starts from and saves its state to, either may be empty.
+*/
+struct SnapshotFiles {
+    std::string load;
+    std::string save;
+};
+
 class ExecutionMode {
 public:
     virtual bool on_init() = 0;
@@ -66,11 +77,12 @@ public:
 
 class InteractiveMode : public ExecutionMode {
 
+    Interpreter::Engine engine;
+    SnapshotFiles snapshot;
     std::unique_ptr<Interpreter::GlobalContext> context;
     std::set<std::string> symbols;
 
-    size_t line_number = 0;
-    std::string code;
+    Parser::Standard::Lexer lexer{ "stdin" };
     std::string line;
 
     std::function<bool()> async_read;
@@ -78,9 +90,22 @@ class InteractiveMode : public ExecutionMode {
 
 public:
 
+    InteractiveMode(Interpreter::Engine engine, SnapshotFiles snapshot) :
+        engine{ engine }, snapshot{ std::move(snapshot) } {}
+
     bool on_init() override {
         context = std::make_unique<Interpreter::GlobalContext>(nullptr);
+        context->engine = engine;
         symbols = context->get_symbols();
+        if (!snapshot.load.empty()) {
+            try {
+                Interpreter::Snapshot::load(*context, Interpreter::Snapshot::Base(*context), snapshot.load);
+            } catch (Interpreter::Snapshot::Exception const& e) {
+                std::cerr << e.what() << std::endl;
+                context.reset();
+                return false;
+            }
+        }
 
         async_read = [this]() {
             return get_line(line);
@@ -93,36 +118,35 @@ public:
     bool on_loop() override {
         if (f.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
             if (f.get()) {
-                if (line.length() > 0) {
-                    ++line_number;
-                    code += line + '\n';
+                lexer.read(line);
+                lexer.read("\n");
 
-                    try {
-                        auto expression = Parser::Standard(code, "stdin").get_tree();
-                        context->caller = expression;
+                if (line.length() > 0) {
+                    if (lexer.is_complete()) {
+                        try {
+                            auto expression = Parser::Standard::get_tree(lexer.get_words());
+                            lexer.clear();
+                            context->caller = expression;
 
-                        auto new_symbols = expression->compute_symbols(symbols);
-                        symbols.insert(new_symbols.begin(), new_symbols.end());
+                            auto new_symbols = expression->compute_symbols(symbols);
+                            symbols.insert(new_symbols.begin(), new_symbols.end());
 
-                        try {
-                            auto r = Interpreter::execute(*context, expression);
                             try {
-                                auto str = Interpreter::string_from(*context, r);
-                                std::cout << str << std::endl;
-                            } catch (Interpreter::Exception const&) {}
-                        } catch (Interpreter::Exception const& ex) {
-                            ex.print_stack_trace(*context);
+                                auto r = Interpreter::execute(*context, expression);
+                                try {
+                                    auto str = Interpreter::string_from(*context, r);
+                                    std::cout << str << std::endl;
+                                } catch (Interpreter::Exception const&) {}
+                            } catch (Interpreter::Exception const& ex) {
+                                ex.print_stack_trace(*context);
+                            }
+                        } catch (Parser::Standard::IncompleteCode const&) {
+                            std::cout << '\t';
+                        } catch (Parser::Standard::Exception const& e) {
+                            std::cerr << e.what();
+                            lexer.clear();
                         }
-
-                        code = "";
-                        for (unsigned i = 0; i < line_number; ++i) code += '\n';
-                    } catch (Parser::Standard::IncompleteCode const&) {
-                        std::cout << '\t';
-                    } catch (Parser::Standard::Exception const& e) {
-                        std::cerr << e.what();
-                        code = "";
-                        for (unsigned i = 0; i < line_number; ++i) code += '\n';
-                    }
+                    } else std::cout << '\t';
                 }
 
                 f = std::async(std::launch::async, async_read);
@@ -147,7 +171,7 @@ public:
     }
 
     int on_exit() override {
-        return EXIT_SUCCESS;
+        return context ? EXIT_SUCCESS : EXIT_FAILURE;
     }
 
 };
@@ -158,6 +182,8 @@ class FileMode : public ExecutionMode {
     bool valid;
     std::string code;
 
+    Interpreter::Engine engine;
+    SnapshotFiles snapshot;
     std::unique_ptr<Interpreter::GlobalContext> context;
 
     Interpreter::Reference r;
@@ -165,8 +191,8 @@ class FileMode : public ExecutionMode {
 
 public:
 
-    FileMode(std::string  path, std::istream& src) :
-        path{ std::move(path) }, valid{ src } {
+    FileMode(std::string  path, std::istream& src, Interpreter::Engine engine, SnapshotFiles snapshot) :
+        path{ std::move(path) }, valid{ src }, engine{ engine }, snapshot{ std::move(snapshot) } {
         if (valid) {
             std::ostringstream oss;
             oss << src.rdbuf();
@@ -180,18 +206,33 @@ public:
                 auto expression = Parser::Standard(code, path).get_tree();
 
                 context = std::make_unique<Interpreter::GlobalContext>(expression);
-                context->sources[std::filesystem::canonical(".")] = expression;
+                context->engine = engine;
 
                 try {
+                    // The symbols are computed without the ones of the snapshot, as when the script imports the files itself
                     std::set<std::string> symbols = context->get_symbols();
+                    std::optional<Interpreter::Snapshot::Base> base;
+                    if (!snapshot.load.empty() || !snapshot.save.empty())
+                        base.emplace(*context);
+                    if (!snapshot.load.empty())
+                        Interpreter::Snapshot::load(*context, *base, snapshot.load);
+                    context->sources[std::filesystem::canonical(".")] = expression;
+
                     expression->compute_symbols(symbols);
+                    Interpreter::prefetch_imports(*context, expression);
 
                     r = Interpreter::execute(*context, expression);
+                    if (!snapshot.save.empty())
+                        Interpreter::Snapshot::save(*context, *base, snapshot.save);
                     return true;
                 } catch (Interpreter::Exception const& ex) {
                     ex.print_stack_trace(*context);
                     error = true;
                     return false;
+                } catch (Interpreter::Snapshot::Exception const& e) {
+                    std::cerr << e.what() << std::endl;
+                    error = true;
+                    return false;
                 }
             } catch (Parser::Standard::IncompleteCode const&) {
                 std::cerr << "incomplete code, you must finish the last expression in file \"" << path << "\"." << std::endl;
@@ -238,6 +279,85 @@ public:
 
 };
 
+/**
+ * Samples the stacks of another mode and writes them to a file when it exits.
+*/
+class ProfileMode : public ExecutionMode {
+
+    std::unique_ptr<ExecutionMode> mode;
+    std::string path;
+    Interpreter::Profiler profiler;
+
+public:
+
+    ProfileMode(std::unique_ptr<ExecutionMode> mode, std::string path) :
+        mode{ std::move(mode) }, path{ std::move(path) } {}
+
+    bool on_init() override {
+        return mode->on_init();
+    }
+
+    bool on_loop() override {
+        return mode->on_loop();
+    }
+
+    int on_exit() override {
+        auto r = mode->on_exit();
+
+        std::ofstream file(path);
+        profiler.write(file);
+        if (!file) {
+            std::cerr << "unable to write the profile file \"" << path << "\"." << std::endl;
+            return EXIT_FAILURE;
+        }
+        return r;
+    }
+
+};
+
+std::unique_ptr<ExecutionMode> get_mode(std::string const& program, std::vector<std::string> const& arguments) {
+    auto engine = Interpreter::Engine::VirtualMachine;
+    SnapshotFiles snapshot;
+    std::string profile;
+    std::vector<std::string> files;
+    bool valid = true;
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        auto const& argument = arguments[i];
+        if (argument == "--tree-walker")
+            engine = Interpreter::Engine::TreeWalker;
+        else if (argument == "--vm")
+            engine = Interpreter::Engine::VirtualMachine;
+        else if (argument == "--snapshot" && i + 1 < arguments.size())
+            snapshot.load = arguments[++i];
+        else if (argument == "--snapshot-save" && i + 1 < arguments.size())
+            snapshot.save = arguments[++i];
+        else if (argument == "--profile" && i + 1 < arguments.size())
+            profile = arguments[++i];
+        else if (argument == "--snapshot" || argument == "--snapshot-save" || argument == "--profile")
+            valid = false;
+        else
+            files.push_back(argument);
+    }
+
+    std::unique_ptr<ExecutionMode> mode;
+    if (valid && files.empty()) {
+        if (is_interactive() && snapshot.save.empty())
+            mode = std::make_unique<InteractiveMode>(engine, std::move(snapshot));
+        else
+            mode = std::make_unique<FileMode>("stdin", std::cin, engine, std::move(snapshot));
+    } else if (valid && files.size() == 1) {
+        std::ifstream src{ files[0] };
+        mode = std::make_unique<FileMode>(files[0], src, engine, std::move(snapshot));
+    } else {
+        std::cerr << "Usage: " << program << " [--tree-walker|--vm] [--snapshot file] [--snapshot-save file] [--profile file] [src]" << std::endl;
+        return nullptr;
+    }
+
+    if (!profile.empty())
+        mode = std::make_unique<ProfileMode>(std::move(mode), std::move(profile));
+    return mode;
+}
+
 
 #ifdef OUVERIUM_WXWIDGETS
 
@@ -255,18 +375,12 @@ public:
         std::srand(std::time(nullptr));
         include_path.push_back((program_location / "libraries").string());
 
-        if (argc == 1) {
-            if (is_interactive())
-                mode = std::make_unique<InteractiveMode>();
-            else
-                mode = std::make_unique<FileMode>("stdin", std::cin);
-        } else if (argc == 2) {
-            std::ifstream src{ std::string(argv[1]) };
-            mode = std::make_unique<FileMode>(std::string(argv[1]), src);
-        } else {
-            std::cerr << "Usage: " << argv[0] << " [src]" << std::endl;
+        std::vector<std::string> arguments;
+        for (int i = 1; i < argc; ++i)
+            arguments.emplace_back(argv[i]);
+        mode = get_mode(std::string(argv[0]), arguments);
+        if (!mode)
             return false;
-        }
 
         if (mode->on_init()) {
             Bind(wxEVT_IDLE, [this](wxIdleEvent& e) {
@@ -299,18 +413,9 @@ int main(int argc, char** argv) {
 
     include_path.push_back((program_location / "libraries").string());
 
-    if (argc == 1) {
-        if (is_interactive())
-            mode = std::make_unique<InteractiveMode>();
-        else
-            mode = std::make_unique<FileMode>("stdin", std::cin);
-    } else if (argc == 2) {
-        std::ifstream src{ argv[1] };
-        mode = std::make_unique<FileMode>(argv[1], src);
-    } else {
-        std::cerr << "Usage: " << argv[0] << " [src]" << std::endl;
+    mode = get_mode(argv[0], std::vector<std::string>(argv + 1, argv + argc));
+    if (!mode)
         return EXIT_FAILURE;
-    }
 
     if (mode->on_init()) {
         while (mode->on_loop());
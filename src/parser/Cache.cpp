@@ -0,0 +1,527 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <ouverium/types.h>
+
+#include "Cache.hpp"
+
+
+namespace Parser::Cache {
+
+    namespace {
+
+        /**
+         * The version of the format of the cached files, to increment each time the format or the expressions change.
+        */
+        uint32_t const version = 1;
+
+        std::string_view const magic = "OVPC";
+
+        /**
+         * Checks that the cached file was written on a machine with the same byte order.
+        */
+        uint32_t const byte_order = 0x01020304;
+
+        enum class Tag : uint8_t {
+            Null,
+            FunctionCall,
+            FunctionDefinition,
+            Property,
+            Symbol,
+            Literal,
+            Tuple
+        };
+
+        /**
+         * Hashes some bytes with FNV-1a.
+         * @param data the bytes.
+         * @param h the hash of the previous bytes.
+         * @return the hash.
+        */
+        uint64_t hash(std::string_view data, uint64_t h = 14695981039346656037ULL) {
+            for (unsigned char c : data) {
+                h ^= c;
+                h *= 1099511628211ULL;
+            }
+            return h;
+        }
+
+        uint64_t hash(std::set<std::string> const& symbols) {
+            uint64_t h = hash(std::string_view());
+            for (auto const& symbol : symbols)
+                h = hash(std::string_view(symbol.c_str(), symbol.size() + 1), h);
+            return h;
+        }
+
+        /**
+         * What a cached file depends on, it is written at the beginning of the file.
+        */
+        struct Key {
+            std::string path;
+            int64_t mtime = 0;
+            uint64_t size = 0;
+            uint64_t code_hash = 0;
+            uint64_t symbols_hash = 0;
+
+            friend bool operator==(Key const& a, Key const& b) = default;
+        };
+
+        bool get_key(Key& key, std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols) {
+            std::error_code ec;
+            auto const mtime = std::filesystem::last_write_time(path, ec);
+            if (ec)
+                return false;
+
+            key.path = path.string();
+            key.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+            key.size = code.size();
+            key.code_hash = hash(code);
+            key.symbols_hash = hash(available_symbols);
+            return true;
+        }
+
+        std::filesystem::path get_file(std::filesystem::path const& directory, std::string const& path) {
+            std::ostringstream oss;
+            oss << std::hex << hash(path) << ".flc";
+            return directory / oss.str();
+        }
+
+        class Writer {
+
+            std::string buffer;
+            std::map<std::string, uint32_t> strings;
+            std::unordered_map<Scope const*, uint32_t> scopes;
+            std::vector<Scope const*> scope_list;
+            std::vector<std::shared_ptr<Expression>>* nodes = nullptr;
+
+            template<typename T>
+            void write(T const& value) {
+                buffer.append(reinterpret_cast<char const*>(&value), sizeof(T));
+            }
+
+            void write_string(std::string const& str) {
+                write(static_cast<uint32_t>(str.size()));
+                buffer.append(str);
+            }
+
+            void write_symbols(std::set<std::string> const& symbols) {
+                write(static_cast<uint32_t>(symbols.size()));
+                for (auto const& symbol : symbols)
+                    write(strings.at(symbol));
+            }
+
+            void write_scope(std::shared_ptr<Scope const> const& scope) {
+                write(scope ? scopes.at(scope.get()) + 1 : uint32_t{ 0 });
+            }
+
+            void add_scope(std::shared_ptr<Scope const> const& scope) {
+                if (scope && !scopes.contains(scope.get())) {
+                    scopes.emplace(scope.get(), static_cast<uint32_t>(scope_list.size()));
+                    scope_list.push_back(scope.get());
+                    for (auto const& symbol : scope->symbols)
+                        strings.emplace(symbol, 0);
+                }
+            }
+
+            void collect(std::shared_ptr<Expression> const& expression) {
+                if (!expression)
+                    return;
+
+                for (auto const& symbol : expression->symbols)
+                    strings.emplace(symbol, 0);
+                add_scope(expression->scope);
+
+                if (auto function_call = std::dynamic_pointer_cast<FunctionCall>(expression)) {
+                    collect(function_call->function);
+                    collect(function_call->arguments);
+                } else if (auto function_definition = std::dynamic_pointer_cast<FunctionDefinition>(expression)) {
+                    for (auto const& capture : function_definition->captures)
+                        strings.emplace(capture, 0);
+                    add_scope(function_definition->function_scope);
+                    collect(function_definition->parameters);
+                    collect(function_definition->filter);
+                    collect(function_definition->body);
+                } else if (auto property = std::dynamic_pointer_cast<Property>(expression)) {
+                    strings.emplace(property->name, 0);
+                    collect(property->object);
+                } else if (auto symbol = std::dynamic_pointer_cast<Symbol>(expression)) {
+                    strings.emplace(symbol->name, 0);
+                } else if (auto tuple = std::dynamic_pointer_cast<Tuple>(expression)) {
+                    for (auto const& object : tuple->objects)
+                        collect(object);
+                }
+            }
+
+            void write_expression(std::shared_ptr<Expression> const& expression) {
+                if (!expression) {
+                    write(Tag::Null);
+                    return;
+                }
+                if (nodes)
+                    nodes->push_back(expression);
+
+                auto const write_header = [this, &expression](Tag tag) {
+                    write(tag);
+                    write(expression->position.line);
+                    write(expression->position.column);
+                    write_symbols(expression->symbols);
+                    write_scope(expression->scope);
+                };
+
+                if (auto function_call = std::dynamic_pointer_cast<FunctionCall>(expression)) {
+                    write_header(Tag::FunctionCall);
+                    write_expression(function_call->function);
+                    write_expression(function_call->arguments);
+                } else if (auto function_definition = std::dynamic_pointer_cast<FunctionDefinition>(expression)) {
+                    write_header(Tag::FunctionDefinition);
+                    write_symbols(function_definition->captures);
+                    write_scope(function_definition->function_scope);
+                    write(static_cast<uint32_t>(function_definition->capture_slots.size()));
+                    for (auto slot : function_definition->capture_slots)
+                        write(static_cast<uint64_t>(slot));
+                    write_expression(function_definition->parameters);
+                    write_expression(function_definition->filter);
+                    write_expression(function_definition->body);
+                } else if (auto property = std::dynamic_pointer_cast<Property>(expression)) {
+                    write_header(Tag::Property);
+                    write(strings.at(property->name));
+                    write_expression(property->object);
+                } else if (auto literal = std::dynamic_pointer_cast<Literal>(expression)) {
+                    write_header(Tag::Literal);
+                    write(strings.at(literal->name));
+                    write(static_cast<uint64_t>(literal->slot));
+                    write(static_cast<uint8_t>(literal->value.index()));
+                    if (auto const* b = std::get_if<bool>(&literal->value))
+                        write(static_cast<uint8_t>(*b));
+                    else if (auto const* i = std::get_if<OV_INT>(&literal->value))
+                        write(*i);
+                    else if (auto const* f = std::get_if<OV_FLOAT>(&literal->value))
+                        write(*f);
+                    else
+                        write_string(std::get<std::string>(literal->value));
+                } else if (auto symbol = std::dynamic_pointer_cast<Symbol>(expression)) {
+                    write_header(Tag::Symbol);
+                    write(strings.at(symbol->name));
+                    write(static_cast<uint64_t>(symbol->slot));
+                } else if (auto tuple = std::dynamic_pointer_cast<Tuple>(expression)) {
+                    write_header(Tag::Tuple);
+                    write(static_cast<uint32_t>(tuple->objects.size()));
+                    for (auto const& object : tuple->objects)
+                        write_expression(object);
+                } else throw std::invalid_argument("unknown expression");
+            }
+
+        public:
+
+            Writer() = default;
+
+            explicit Writer(std::vector<std::shared_ptr<Expression>>& nodes) :
+                nodes(&nodes) {}
+
+            std::string serialize(std::shared_ptr<Expression> const& expression) {
+                collect(expression);
+                uint32_t index = 0;
+                for (auto& [str, i] : strings)
+                    i = index++;
+
+                write(static_cast<uint32_t>(strings.size()));
+                for (auto const& [str, i] : strings)
+                    write_string(str);
+
+                write(static_cast<uint32_t>(scope_list.size()));
+                for (auto const* scope : scope_list) {
+                    write(static_cast<uint32_t>(scope->symbols.size()));
+                    for (auto const& symbol : scope->symbols)
+                        write(strings.at(symbol));
+                }
+
+                write_expression(expression);
+                return std::move(buffer);
+            }
+
+            std::string serialize(Key const& key, std::shared_ptr<Expression> const& expression) {
+                buffer.append(magic);
+                write(version);
+                write(byte_order);
+                write(static_cast<uint8_t>(sizeof(OV_INT)));
+                write(static_cast<uint8_t>(sizeof(OV_FLOAT)));
+                write_string(key.path);
+                write(key.mtime);
+                write(key.size);
+                write(key.code_hash);
+                write(key.symbols_hash);
+
+                return serialize(expression);
+            }
+
+        };
+
+        /**
+         * Reads a cached file or a serialized tree, throws a std::out_of_range if it is truncated or corrupted.
+        */
+        class Reader {
+
+            std::string_view data;
+            size_t offset = 0;
+            uint32_t file = 0;
+            std::vector<std::string> strings;
+            std::vector<std::shared_ptr<Scope const>> scopes;
+            std::vector<std::shared_ptr<Expression>>* nodes = nullptr;
+
+            template<typename T>
+            T read() {
+                if (data.size() - offset < sizeof(T))
+                    throw std::out_of_range("truncated cache");
+                T value;
+                std::memcpy(&value, data.data() + offset, sizeof(T));
+                offset += sizeof(T);
+                return value;
+            }
+
+            std::string read_string() {
+                auto const size = read<uint32_t>();
+                if (data.size() - offset < size)
+                    throw std::out_of_range("truncated cache");
+                std::string str(data.substr(offset, size));
+                offset += size;
+                return str;
+            }
+
+            /**
+             * Reads a number of elements, checked against the bytes left so that a corrupted number is not allocated.
+             * @param element_size the smallest number of bytes of an element.
+             * @return the number of elements.
+            */
+            uint32_t read_count(size_t element_size) {
+                auto const count = read<uint32_t>();
+                if ((data.size() - offset) / element_size < count)
+                    throw std::out_of_range("truncated cache");
+                return count;
+            }
+
+            std::string const& read_index() {
+                return strings.at(read<uint32_t>());
+            }
+
+            std::set<std::string> read_symbols() {
+                std::set<std::string> symbols;
+                auto const size = read_count(sizeof(uint32_t));
+                for (uint32_t i = 0; i < size; ++i)
+                    symbols.insert(symbols.end(), read_index());
+                return symbols;
+            }
+
+            std::shared_ptr<Scope const> read_scope() {
+                auto const id = read<uint32_t>();
+                return id == 0 ? nullptr : scopes.at(id - 1);
+            }
+
+            std::shared_ptr<Expression> read_expression(std::shared_ptr<Expression> const& parent) {
+                auto const tag = read<Tag>();
+
+                std::shared_ptr<Expression> expression;
+                switch (tag) {
+                    case Tag::Null: return nullptr;
+                    case Tag::FunctionCall: expression = std::make_shared<FunctionCall>(); break;
+                    case Tag::FunctionDefinition: expression = std::make_shared<FunctionDefinition>(); break;
+                    case Tag::Property: expression = std::make_shared<Property>(); break;
+                    case Tag::Symbol: expression = std::make_shared<Symbol>(); break;
+                    case Tag::Literal: expression = std::make_shared<Literal>("", false); break;
+                    case Tag::Tuple: expression = std::make_shared<Tuple>(); break;
+                    default: throw std::out_of_range("unknown expression");
+                }
+                if (nodes)
+                    nodes->push_back(expression);
+
+                expression->parent = parent;
+                auto const line = read<uint32_t>();
+                auto const column = read<uint32_t>();
+                expression->position = Position(file, line, column);
+                expression->symbols = read_symbols();
+                expression->scope = read_scope();
+
+                if (auto function_call = std::dynamic_pointer_cast<FunctionCall>(expression)) {
+                    function_call->function = read_expression(expression);
+                    function_call->arguments = read_expression(expression);
+                } else if (auto function_definition = std::dynamic_pointer_cast<FunctionDefinition>(expression)) {
+                    function_definition->captures = read_symbols();
+                    function_definition->function_scope = read_scope();
+                    auto const size = read_count(sizeof(uint64_t));
+                    function_definition->capture_slots.reserve(size);
+                    for (uint32_t i = 0; i < size; ++i)
+                        function_definition->capture_slots.push_back(static_cast<size_t>(read<uint64_t>()));
+                    function_definition->parameters = read_expression(expression);
+                    function_definition->filter = read_expression(expression);
+                    function_definition->body = read_expression(expression);
+                } else if (auto property = std::dynamic_pointer_cast<Property>(expression)) {
+                    property->name = read_index();
+                    property->object = read_expression(expression);
+                } else if (auto literal = std::dynamic_pointer_cast<Literal>(expression)) {
+                    literal->name = read_index();
+                    literal->slot = static_cast<size_t>(read<uint64_t>());
+                    switch (read<uint8_t>()) {
+                        case 0: literal->value = read<uint8_t>() != 0; break;
+                        case 1: literal->value = read<OV_INT>(); break;
+                        case 2: literal->value = read<OV_FLOAT>(); break;
+                        case 3: literal->value = read_string(); break;
+                        default: throw std::out_of_range("unknown literal");
+                    }
+                } else if (auto symbol = std::dynamic_pointer_cast<Symbol>(expression)) {
+                    symbol->name = read_index();
+                    symbol->slot = static_cast<size_t>(read<uint64_t>());
+                } else if (auto tuple = std::dynamic_pointer_cast<Tuple>(expression)) {
+                    auto const size = read_count(sizeof(Tag));
+                    tuple->objects.reserve(size);
+                    for (uint32_t i = 0; i < size; ++i)
+                        tuple->objects.push_back(read_expression(expression));
+                }
+
+                return expression;
+            }
+
+        public:
+
+            explicit Reader(std::string_view data) :
+                data(data) {}
+
+            Reader(std::string_view data, std::vector<std::shared_ptr<Expression>>& nodes) :
+                data(data), nodes(&nodes) {}
+
+            std::shared_ptr<Expression> deserialize(std::string const& path) {
+                file = Position::get_file(path);
+
+                auto const string_count = read_count(sizeof(uint32_t));
+                strings.reserve(string_count);
+                for (uint32_t i = 0; i < string_count; ++i)
+                    strings.push_back(read_string());
+
+                auto const scope_count = read_count(sizeof(uint32_t));
+                scopes.reserve(scope_count);
+                for (uint32_t i = 0; i < scope_count; ++i) {
+                    Scope scope;
+                    auto const size = read_count(sizeof(uint32_t));
+                    scope.symbols.reserve(size);
+                    for (uint32_t j = 0; j < size; ++j)
+                        scope.symbols.push_back(read_index());
+                    scopes.push_back(std::make_shared<Scope const>(std::move(scope)));
+                }
+
+                auto expression = read_expression(nullptr);
+                if (offset != data.size())
+                    throw std::out_of_range("trailing bytes");
+                return expression;
+            }
+
+            std::shared_ptr<Expression> deserialize(Key const& key) {
+                if (data.substr(0, magic.size()) != magic)
+                    return nullptr;
+                offset = magic.size();
+                if (read<uint32_t>() != version || read<uint32_t>() != byte_order)
+                    return nullptr;
+                if (read<uint8_t>() != sizeof(OV_INT) || read<uint8_t>() != sizeof(OV_FLOAT))
+                    return nullptr;
+
+                Key cached;
+                cached.path = read_string();
+                cached.mtime = read<int64_t>();
+                cached.size = read<uint64_t>();
+                cached.code_hash = read<uint64_t>();
+                cached.symbols_hash = read<uint64_t>();
+                if (!(cached == key))
+                    return nullptr;
+
+                return deserialize(key.path);
+            }
+
+        };
+
+    }
+
+    std::filesystem::path get_directory() {
+        static auto const directory = []() -> std::filesystem::path {
+            if (auto const* cache = std::getenv("OUVERIUM_CACHE"))
+                return cache;
+            if (auto const* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg)
+                return std::filesystem::path(xdg) / "ouverium";
+            if (auto const* home = std::getenv("HOME"); home && *home)
+                return std::filesystem::path(home) / ".cache" / "ouverium";
+            if (auto const* local = std::getenv("LOCALAPPDATA"); local && *local)
+                return std::filesystem::path(local) / "ouverium";
+            return {};
+        }();
+        return directory;
+    }
+
+    std::shared_ptr<Expression> load(std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols) {
+        auto const directory = get_directory();
+        Key key;
+        if (directory.empty() || !get_key(key, path, code, available_symbols))
+            return nullptr;
+
+        std::ifstream file(get_file(directory, key.path), std::ios::binary | std::ios::ate);
+        if (!file)
+            return nullptr;
+        std::string data(static_cast<size_t>(file.tellg()), '\0');
+        file.seekg(0);
+        if (!file.read(data.data(), static_cast<std::streamsize>(data.size())))
+            return nullptr;
+
+        try {
+            return Reader(data).deserialize(key);
+        } catch (std::out_of_range const&) {
+            return nullptr;
+        }
+    }
+
+    std::string serialize(std::shared_ptr<Expression> const& expression, std::vector<std::shared_ptr<Expression>>& nodes) {
+        return Writer(nodes).serialize(expression);
+    }
+
+    std::shared_ptr<Expression> deserialize(std::string_view data, std::string const& path, std::vector<std::shared_ptr<Expression>>& nodes) {
+        return Reader(data, nodes).deserialize(path);
+    }
+
+    void store(std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols, std::shared_ptr<Expression> const& expression) {
+        auto const directory = get_directory();
+        Key key;
+        if (directory.empty() || !get_key(key, path, code, available_symbols))
+            return;
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        if (ec)
+            return;
+
+        auto const data = Writer().serialize(key, expression);
+
+        // The file is written aside and renamed, so that concurrent processes never read a partial file
+        auto const target = get_file(directory, key.path);
+        auto temporary = target;
+        temporary += "." + std::to_string(std::random_device()()) + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary);
+            if (!file.write(data.data(), static_cast<std::streamsize>(data.size())))
+                ec = std::make_error_code(std::errc::io_error);
+        }
+        if (!ec)
+            std::filesystem::rename(temporary, target, ec);
+        if (ec)
+            std::filesystem::remove(temporary, ec);
+    }
+
+}
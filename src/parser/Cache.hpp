@@ -0,0 +1,63 @@
+#ifndef __PARSER_CACHE_HPP__
+#define __PARSER_CACHE_HPP__
+
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Expressions.hpp"
+
+
+namespace Parser::Cache {
+
+    /**
+     * Gets the directory of the cache of the parsed source files.
+     * It is the OUVERIUM_CACHE environment variable if it is defined, and the cache is disabled if it is empty.
+     * Otherwise it is the ouverium directory in the cache directory of the user.
+     * @return the directory, empty if the cache is disabled.
+    */
+    [[nodiscard]] std::filesystem::path get_directory();
+
+    /**
+     * Loads the tree of a source file from the cache, with its symbols already computed.
+     * @param path the canonical path of the source file.
+     * @param code the content of the source file.
+     * @param available_symbols the symbols available when the symbols of the tree were computed.
+     * @return the tree, or null if it is not in the cache or if the cached tree is outdated.
+    */
+    [[nodiscard]] std::shared_ptr<Expression> load(std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols);
+
+    /**
+     * Stores the tree of a source file in the cache, once its symbols are computed.
+     * The cache is left unchanged if the tree cannot be written.
+     * @param path the canonical path of the source file.
+     * @param code the content of the source file.
+     * @param available_symbols the symbols available when the symbols of the tree were computed.
+     * @param expression the tree.
+    */
+    void store(std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols, std::shared_ptr<Expression> const& expression);
+
+    /**
+     * Serializes a tree with its symbols, in the format of the cached files but without their header.
+     * @param expression the tree.
+     * @param nodes the expressions of the tree are added to it, in the order of the serialization.
+     * @return the serialized tree.
+    */
+    [[nodiscard]] std::string serialize(std::shared_ptr<Expression> const& expression, std::vector<std::shared_ptr<Expression>>& nodes);
+
+    /**
+     * Deserializes a tree serialized by serialize, throws a std::out_of_range if it is truncated or corrupted.
+     * @param data the serialized tree.
+     * @param path the path of the source file of the tree.
+     * @param nodes the expressions of the tree are added to it, in the order of the serialization.
+     * @return the tree.
+    */
+    [[nodiscard]] std::shared_ptr<Expression> deserialize(std::string_view data, std::string const& path, std::vector<std::shared_ptr<Expression>>& nodes);
+
+}
+
+
+#endif
@@ -1,12 +1,12 @@
 #include "Expressions.hpp"
 
-#include "../Types.hpp"
-
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <set>
 #include <string>
-#include <variant>
+#include <utility>
+#include <vector>
 
 
 namespace Parser {
@@ -26,6 +26,14 @@ namespace Parser {
 
     }
 
+    size_t Scope::get_slot(std::string const& symbol) const {
+        auto it = std::lower_bound(symbols.begin(), symbols.end(), symbol);
+        if (it != symbols.end() && *it == symbol)
+            return static_cast<size_t>(it - symbols.begin());
+        else
+            return symbols.size();
+    }
+
     std::shared_ptr<Expression> Expression::get_root() {
         auto root = shared_from_this();
         while (root->parent.lock() != nullptr)
@@ -79,10 +87,25 @@ namespace Parser {
                 used_symbols.insert(s);
 
         captures = used_symbols;
+        compute_scope();
 
         return used_symbols;
     }
 
+    void FunctionDefinition::compute_scope() {
+        std::vector<std::string> slots(symbols.begin(), symbols.end());
+        if (!function_scope || function_scope->symbols != slots)
+            function_scope = std::make_shared<Scope const>(Scope{ std::move(slots) });
+
+        capture_slots.clear();
+        for (auto const& capture : captures)
+            capture_slots.push_back(function_scope->get_slot(capture));
+
+        parameters->set_scope(function_scope);
+        if (filter) filter->set_scope(function_scope);
+        body->set_scope(function_scope);
+    }
+
     std::set<std::string> Property::get_symbols() const {
         return object->get_symbols();
     }
@@ -96,21 +119,24 @@ namespace Parser {
     }
 
     std::set<std::string> Symbol::get_symbols() const {
-        if (std::holds_alternative<std::nullptr_t>(get_symbol(name)))
-            return { name };
-        else
-            return {};
+        return { name };
     }
 
     std::set<std::string> Symbol::compute_symbols(std::set<std::string>& available_symbols) {
-        if (std::holds_alternative<std::nullptr_t>(get_symbol(name))) {
-            symbols.insert(name);
-            available_symbols.insert(name);
-        }
+        symbols.insert(name);
+        available_symbols.insert(name);
 
         return symbols;
     }
 
+    std::set<std::string> Literal::get_symbols() const {
+        return {};
+    }
+
+    std::set<std::string> Literal::compute_symbols(std::set<std::string>& /*available_symbols*/) {
+        return symbols;
+    }
+
     std::set<std::string> Tuple::get_symbols() const {
         std::set<std::string> symbols;
 
@@ -129,6 +155,89 @@ namespace Parser {
         return symbols;
     }
 
+    void FunctionCall::set_scope(std::shared_ptr<Scope const> const& scope) {
+        this->scope = scope;
+        function->set_scope(scope);
+        arguments->set_scope(scope);
+    }
+
+    void FunctionDefinition::set_scope(std::shared_ptr<Scope const> const& scope) {
+        this->scope = scope;
+    }
+
+    void Property::set_scope(std::shared_ptr<Scope const> const& scope) {
+        this->scope = scope;
+        object->set_scope(scope);
+    }
+
+    void Symbol::set_scope(std::shared_ptr<Scope const> const& scope) {
+        this->scope = scope;
+        if (scope)
+            slot = scope->get_slot(name);
+    }
+
+    void Tuple::set_scope(std::shared_ptr<Scope const> const& scope) {
+        this->scope = scope;
+        for (auto const& ex : objects)
+            ex->set_scope(scope);
+    }
+
+    SymbolResolver::SymbolResolver(std::shared_ptr<Expression> const& root) {
+        index(root);
+    }
+
+    void SymbolResolver::index(std::shared_ptr<Expression> const& expression) {
+        if (auto function_call = std::dynamic_pointer_cast<FunctionCall>(expression)) {
+            index(function_call->function);
+            index(function_call->arguments);
+        } else if (auto function_definition = std::dynamic_pointer_cast<FunctionDefinition>(expression)) {
+            for (auto const& symbol : function_definition->symbols)
+                definitions[symbol].push_back(function_definition);
+            index(function_definition->parameters);
+            if (function_definition->filter) index(function_definition->filter);
+            index(function_definition->body);
+        } else if (auto property = std::dynamic_pointer_cast<Property>(expression)) {
+            index(property->object);
+        } else if (auto tuple = std::dynamic_pointer_cast<Tuple>(expression)) {
+            for (auto const& object : tuple->objects)
+                index(object);
+        }
+    }
+
+    void SymbolResolver::add_symbols(std::set<std::string> const& symbols) {
+        std::set<std::shared_ptr<FunctionDefinition>> modified;
+
+        for (auto const& symbol : symbols) {
+            if (!available.insert(symbol).second)
+                continue;
+
+            auto it = definitions.find(symbol);
+            if (it == definitions.end())
+                continue;
+
+            // A function definition using a newly available symbol captures it, and so do its parents up to one which already captures it
+            auto const users = it->second;
+            for (auto const& user : users) {
+                std::shared_ptr<Expression> expression = user.lock();
+                while (expression) {
+                    if (auto function_definition = std::dynamic_pointer_cast<FunctionDefinition>(expression)) {
+                        if (function_definition->symbols.insert(symbol).second)
+                            it->second.push_back(function_definition);
+                        if (!function_definition->captures.insert(symbol).second)
+                            break;
+                        modified.insert(function_definition);
+                    } else if (!expression->symbols.insert(symbol).second)
+                        break;
+
+                    expression = expression->parent.lock();
+                }
+            }
+        }
+
+        for (auto const& function_definition : modified)
+            function_definition->compute_scope();
+    }
+
     std::string FunctionCall::to_string(unsigned n) const {
         std::string s;
         s += "FunctionCall:\n";
@@ -163,6 +272,10 @@ namespace Parser {
         return "Symbol: " + name + "\n";
     }
 
+    std::string Literal::to_string(unsigned int /*n*/) const {
+        return "Literal: " + name + "\n";
+    }
+
     std::string Tuple::to_string(unsigned int n) const {
         std::string s;
         s += "Tuple:\n";
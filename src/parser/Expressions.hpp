@@ -1,17 +1,52 @@
 #ifndef __PARSER_EXPRESSIONS_HPP__
 #define __PARSER_EXPRESSIONS_HPP__
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <ouverium/types.h>
+
+#include "Position.hpp"
+
+
+namespace Compiler {
+    struct Bytecode;
+}
+
+namespace Interpreter {
+    struct DispatchCache;
+}
 
 namespace Parser {
 
-    using Position = std::string;
+    /**
+     * The symbols of a function, each one is stored in a slot of the contexts of the function.
+    */
+    struct Scope {
+
+        /**
+         * The sorted symbols, the index of a symbol is its slot.
+        */
+        std::vector<std::string> symbols;
+
+        /**
+         * Gets the slot of a symbol.
+         * @param symbol the symbol.
+         * @return the slot of the symbol, or the number of symbols if it is not in the scope.
+        */
+        [[nodiscard]] size_t get_slot(std::string const& symbol) const;
+
+    };
 
     /**
      * Represents an expression of the language, must be inherited.
@@ -39,6 +74,24 @@ namespace Parser {
         */
         std::set<std::string> symbols;
 
+        /**
+         * The scope in which the expression is executed, null for the global scope.
+        */
+        std::shared_ptr<Scope const> scope;
+
+        /**
+         * The bytecode of the expression, compiled on its first execution by the virtual machine and published once.
+        */
+        std::atomic<std::shared_ptr<Compiler::Bytecode const>> bytecode;
+
+        Expression() = default;
+
+        /**
+         * Copies an expression without its bytecode, which is compiled again for the copy.
+        */
+        Expression(Expression const& expression) :
+            std::enable_shared_from_this<Expression>(), parent(expression.parent), position(expression.position), symbols(expression.symbols), scope(expression.scope) {}
+
         /**
          * Gets all the symbols present in this expression.
          * @return the symbols present in this expression.
@@ -52,6 +105,12 @@ namespace Parser {
         */
         virtual std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) = 0;
 
+        /**
+         * Sets the scope of this expressions tree, up to the function definitions which have their own scope.
+         * @param scope the scope.
+        */
+        virtual void set_scope(std::shared_ptr<Scope const> const& scope) = 0;
+
         /**
          * Gets a string of the expression to print it as a tree.
          * @return the expression as a string.
@@ -67,11 +126,17 @@ namespace Parser {
         std::shared_ptr<Expression> function;
         std::shared_ptr<Expression> arguments;
 
+        /**
+         * The dispatch cache of the interpreter, replaced as a whole when a callee or its overloads change.
+        */
+        mutable std::atomic<std::shared_ptr<Interpreter::DispatchCache const>> dispatch;
+
         FunctionCall(std::shared_ptr<Expression> function = nullptr, std::shared_ptr<Expression> arguments = nullptr) :
             function(std::move(function)), arguments(std::move(arguments)) {}
 
         std::set<std::string> get_symbols() const override;
         std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) override;
+        void set_scope(std::shared_ptr<Scope const> const& scope) override;
         std::string to_string(unsigned n = 0) const override;
 
     };
@@ -80,6 +145,16 @@ namespace Parser {
 
         std::set<std::string> captures;
 
+        /**
+         * The scope of the parameters, the filter and the body.
+        */
+        std::shared_ptr<Scope const> function_scope;
+
+        /**
+         * The slots of the captures in the scope of the function, in the order of the captures.
+        */
+        std::vector<size_t> capture_slots;
+
         std::shared_ptr<Expression> parameters;
         std::shared_ptr<Expression> filter;
         std::shared_ptr<Expression> body;
@@ -89,8 +164,14 @@ namespace Parser {
 
         std::set<std::string> get_symbols() const override;
         std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) override;
+        void set_scope(std::shared_ptr<Scope const> const& scope) override;
         std::string to_string(unsigned int n = 0) const override;
 
+        /**
+         * Computes the scope of the function and the slots of the captures from its symbols and its captures.
+        */
+        void compute_scope();
+
     };
 
     struct Property : public Expression {
@@ -98,11 +179,17 @@ namespace Parser {
         std::shared_ptr<Expression> object;
         std::string name;
 
+        /**
+         * The inline cache of the interpreter, each entry packs the id of a shape in its high half and the slot of the property in its low half.
+        */
+        mutable std::array<std::atomic<uint64_t>, 4> cache{};
+
         Property(std::shared_ptr<Expression> object = nullptr, std::string name = "") :
             object(std::move(object)), name(std::move(name)) {}
 
         std::set<std::string> get_symbols() const override;
         std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) override;
+        void set_scope(std::shared_ptr<Scope const> const& scope) override;
         std::string to_string(unsigned int n = 0) const override;
 
     };
@@ -111,9 +198,33 @@ namespace Parser {
 
         std::string name;
 
+        /**
+         * The slot of the symbol in its scope.
+        */
+        size_t slot = 0;
+
         Symbol(std::string name = "") :
             name(std::move(name)) {}
 
+        std::set<std::string> get_symbols() const override;
+        std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) override;
+        void set_scope(std::shared_ptr<Scope const> const& scope) override;
+        std::string to_string(unsigned int n = 0) const override;
+
+    };
+
+    /**
+     * A symbol which is a boolean, an integer, a float or a string literal, decoded once by the parser.
+    */
+    struct Literal : public Symbol {
+
+        using Value = std::variant<bool, OV_INT, OV_FLOAT, std::string>;
+
+        Value value;
+
+        Literal(std::string name, Value value) :
+            Symbol(std::move(name)), value(std::move(value)) {}
+
         std::set<std::string> get_symbols() const override;
         std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) override;
         std::string to_string(unsigned int n = 0) const override;
@@ -129,10 +240,41 @@ namespace Parser {
 
         std::set<std::string> get_symbols() const override;
         std::set<std::string> compute_symbols(std::set<std::string>& available_symbols) override;
+        void set_scope(std::shared_ptr<Scope const> const& scope) override;
         std::string to_string(unsigned int n = 0) const override;
 
     };
 
+    /**
+     * Makes some symbols available at the top level of a tree whose symbols are computed, for instance the symbols of an imported file.
+     * The tree gets the same symbols as if they were all computed again, but only the function definitions using the new symbols and their parents are visited.
+    */
+    class SymbolResolver {
+
+        /**
+         * The symbols already available at the top level of the tree.
+        */
+        std::set<std::string> available;
+
+        /**
+         * The function definitions of the tree by the symbols they use.
+        */
+        std::map<std::string, std::vector<std::weak_ptr<FunctionDefinition>>> definitions;
+
+        void index(std::shared_ptr<Expression> const& expression);
+
+    public:
+
+        explicit SymbolResolver(std::shared_ptr<Expression> const& root);
+
+        /**
+         * Makes some symbols available in the tree.
+         * @param symbols the symbols.
+        */
+        void add_symbols(std::set<std::string> const& symbols);
+
+    };
+
 }
 
 
@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "Position.hpp"
+
+
+namespace Parser {
+
+    namespace {
+
+        /**
+         * The paths of the files, the id of a path is its index plus one.
+         * A deque is used so that the paths are never moved.
+        */
+        struct Files {
+            std::mutex mutex;
+            std::deque<std::string> paths;
+            std::unordered_map<std::string, uint32_t> ids;
+        };
+
+        Files& get_files() {
+            static Files files;
+            return files;
+        }
+
+    }
+
+    uint32_t Position::get_file(std::string const& path) {
+        auto& files = get_files();
+        std::lock_guard lock(files.mutex);
+
+        auto it = files.ids.find(path);
+        if (it != files.ids.end())
+            return it->second;
+
+        files.paths.push_back(path);
+        auto id = static_cast<uint32_t>(files.paths.size());
+        files.ids.emplace(path, id);
+        return id;
+    }
+
+    std::string const& Position::get_path() const {
+        static std::string const empty;
+        if (file == 0)
+            return empty;
+
+        auto& files = get_files();
+        std::lock_guard lock(files.mutex);
+        return files.paths[file - 1];
+    }
+
+    std::string Position::to_string() const {
+        if (file == 0)
+            return {};
+        else
+            return "file " + get_path() + ":" + std::to_string(line) + ":" + std::to_string(column);
+    }
+
+    std::ostream& operator<<(std::ostream& os, Position const& position) {
+        return os << position.to_string();
+    }
+
+}
@@ -0,0 +1,56 @@
+#ifndef __PARSER_POSITION_HPP__
+#define __PARSER_POSITION_HPP__
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+
+namespace Parser {
+
+    /**
+     * A position in a source file, which is only formatted when it is printed.
+    */
+    struct Position {
+
+        /**
+         * The id of the path of the file in the table of the files, zero if there is no file.
+        */
+        uint32_t file = 0;
+
+        uint32_t line = 0;
+        uint32_t column = 0;
+
+        Position() = default;
+        Position(uint32_t file, uint32_t line, uint32_t column) :
+            file(file), line(line), column(column) {}
+
+        /**
+         * Gets the id of a file, which is added to the table of the files the first time.
+         * @param path the path of the file.
+         * @return the id of the file.
+        */
+        [[nodiscard]] static uint32_t get_file(std::string const& path);
+
+        /**
+         * Gets the path of the file.
+         * @return the path, empty if there is no file.
+        */
+        [[nodiscard]] std::string const& get_path() const;
+
+        /**
+         * Formats the position as "file path:line:column".
+         * @return the formatted position, empty if there is no file.
+        */
+        [[nodiscard]] std::string to_string() const;
+
+        friend bool operator==(Position const& a, Position const& b) = default;
+
+    };
+
+    std::ostream& operator<<(std::ostream& os, Position const& position);
+
+}
+
+
+#endif
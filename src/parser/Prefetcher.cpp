@@ -0,0 +1,199 @@
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Cache.hpp"
+#include "Prefetcher.hpp"
+#include "Standard.hpp"
+
+
+namespace Parser {
+
+    namespace {
+
+        /**
+         * Finds the files imported by a tree with a string literal, in the order of the source.
+         * @param expression the tree.
+         * @param resolver the resolver of the imported files.
+         * @return the canonical paths of the files.
+        */
+        std::vector<std::filesystem::path> find_imports(std::shared_ptr<Expression> const& expression, Prefetcher::Resolver const& resolver) {
+            std::vector<std::filesystem::path> paths;
+
+            // The tree is walked with a stack, as a long sequence of statements is a deep tree
+            std::vector<Expression const*> stack = { expression.get() };
+            while (!stack.empty()) {
+                auto const* e = stack.back();
+                stack.pop_back();
+                if (e == nullptr)
+                    continue;
+
+                if (auto const* function_call = dynamic_cast<FunctionCall const*>(e)) {
+                    auto const* symbol = dynamic_cast<Symbol const*>(function_call->function.get());
+                    if (symbol && symbol->name == "import" && dynamic_cast<Literal const*>(symbol) == nullptr) {
+                        auto const* literal = dynamic_cast<Literal const*>(function_call->arguments.get());
+                        if (auto const* tuple = dynamic_cast<Tuple const*>(function_call->arguments.get()); tuple && tuple->objects.size() == 1)
+                            literal = dynamic_cast<Literal const*>(tuple->objects.front().get());
+
+                        if (auto const* str = literal ? std::get_if<std::string>(&literal->value) : nullptr)
+                            if (auto path = resolver(*str, function_call->position.get_path()))
+                                paths.push_back(std::move(*path));
+                    }
+
+                    stack.push_back(function_call->arguments.get());
+                    stack.push_back(function_call->function.get());
+                } else if (auto const* function_definition = dynamic_cast<FunctionDefinition const*>(e)) {
+                    stack.push_back(function_definition->body.get());
+                    stack.push_back(function_definition->filter.get());
+                    stack.push_back(function_definition->parameters.get());
+                } else if (auto const* property = dynamic_cast<Property const*>(e)) {
+                    stack.push_back(property->object.get());
+                } else if (auto const* tuple = dynamic_cast<Tuple const*>(e)) {
+                    for (auto it = tuple->objects.rbegin(); it != tuple->objects.rend(); ++it)
+                        stack.push_back(it->get());
+                }
+            }
+
+            return paths;
+        }
+
+    }
+
+    Prefetcher::Prefetcher(std::set<std::string> available_symbols, Resolver resolver, std::set<std::filesystem::path> const& imported) :
+        available_symbols(std::move(available_symbols)), resolver(std::move(resolver)) {
+        // The imported files are known without being parsed, their trees are not used anymore
+        for (auto const& path : imported) {
+            auto file = std::make_shared<File>();
+            std::promise<void> promise;
+            file->ready = promise.get_future().share();
+            promise.set_value();
+            files.emplace(path, std::move(file));
+        }
+    }
+
+    Prefetcher::~Prefetcher() {
+        {
+            std::lock_guard lock(mutex);
+            stopped = true;
+        }
+        condition.notify_all();
+
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    void Prefetcher::schedule(std::vector<std::filesystem::path> const& paths) {
+        for (auto const& path : paths) {
+            if (files.contains(path))
+                continue;
+
+            auto file = std::make_shared<File>();
+            std::promise<void> promise;
+            file->ready = promise.get_future().share();
+            files.emplace(path, std::move(file));
+            queue.emplace_back(path, std::move(promise));
+            ++scheduled;
+        }
+
+        auto const threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()), scheduled);
+        while (workers.size() < threads)
+            workers.emplace_back(&Prefetcher::work, this);
+        condition.notify_all();
+    }
+
+    void Prefetcher::work() {
+        std::unique_lock lock(mutex);
+        while (true) {
+            condition.wait(lock, [this]() {
+                return stopped || !queue.empty();
+            });
+            if (stopped)
+                return;
+
+            auto [path, promise] = std::move(queue.front());
+            queue.pop_front();
+            auto file = files.at(path);
+            lock.unlock();
+
+            std::vector<std::filesystem::path> imports;
+            std::ifstream src(path);
+            if (src) {
+                std::ostringstream oss;
+                oss << src.rdbuf();
+                file->code = oss.str();
+
+                try {
+                    file->expression = parse(path, file->code, available_symbols);
+                    imports = find_imports(file->expression, resolver);
+                } catch (...) {
+                    file->exception = std::current_exception();
+                }
+            }
+            promise.set_value();
+
+            lock.lock();
+            if (!stopped)
+                schedule(imports);
+        }
+    }
+
+    void Prefetcher::prefetch(std::shared_ptr<Expression> const& expression) {
+        auto imports = find_imports(expression, resolver);
+
+        std::lock_guard lock(mutex);
+        schedule(imports);
+    }
+
+    std::shared_ptr<Expression> Prefetcher::get(std::filesystem::path const& path, std::string const& code) {
+        std::shared_ptr<File> file;
+        {
+            std::lock_guard lock(mutex);
+            auto it = files.find(path);
+            if (it == files.end())
+                return nullptr;
+            file = it->second;
+
+            // A file which is not being parsed yet is parsed by the caller rather than waited for
+            auto queued = std::find_if(queue.begin(), queue.end(), [&path](auto const& entry) {
+                return entry.first == path;
+            });
+            if (queued != queue.end()) {
+                queued->second.set_value();
+                queue.erase(queued);
+                return nullptr;
+            }
+        }
+
+        file->ready.wait();
+        if (file->code != code || (!file->expression && !file->exception))
+            return nullptr;
+        if (file->exception)
+            std::rethrow_exception(file->exception);
+        return file->expression;
+    }
+
+    std::shared_ptr<Expression> Prefetcher::parse(std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols) {
+        auto expression = Cache::load(path, code, available_symbols);
+        if (!expression) {
+            expression = Standard(code, path.string()).get_tree();
+
+            auto symbols = available_symbols;
+            expression->compute_symbols(symbols);
+            Cache::store(path, code, available_symbols, expression);
+        }
+        return expression;
+    }
+
+}
@@ -0,0 +1,115 @@
+#ifndef __PARSER_PREFETCHER_HPP__
+#define __PARSER_PREFETCHER_HPP__
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Expressions.hpp"
+
+
+namespace Parser {
+
+    /**
+     * Parses the files imported by a tree on a pool of threads, so that their trees are ready when they are imported.
+     * The files imported by the parsed files are parsed too. Nothing is executed, the files are still imported in the order of the execution.
+    */
+    class Prefetcher {
+
+    public:
+
+        /**
+         * Gets the canonical path of an imported file, or nothing if it can not be found.
+         * The first argument is the path written in the import, the second one the path of the file which imports it.
+        */
+        using Resolver = std::function<std::optional<std::filesystem::path>(std::string const&, std::string const&)>;
+
+    private:
+
+        struct File {
+            std::string code;
+            std::shared_ptr<Expression> expression;
+            std::exception_ptr exception;
+            std::shared_future<void> ready;
+        };
+
+        std::set<std::string> available_symbols;
+        Resolver resolver;
+
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::map<std::filesystem::path, std::shared_ptr<File>> files;
+        std::deque<std::pair<std::filesystem::path, std::promise<void>>> queue;
+        std::vector<std::thread> workers;
+        size_t scheduled = 0;
+        bool stopped = false;
+
+        /**
+         * Queues the files which are not known yet, the mutex must be locked.
+         * @param paths the canonical paths of the files.
+        */
+        void schedule(std::vector<std::filesystem::path> const& paths);
+        void work();
+
+    public:
+
+        /**
+         * @param available_symbols the symbols available when the symbols of the imported files are computed.
+         * @param resolver the resolver of the imported files.
+         * @param imported the files already imported, which are not parsed.
+        */
+        Prefetcher(std::set<std::string> available_symbols, Resolver resolver, std::set<std::filesystem::path> const& imported);
+        Prefetcher(Prefetcher const&) = delete;
+        Prefetcher(Prefetcher&&) = delete;
+
+        Prefetcher& operator=(Prefetcher const&) = delete;
+        Prefetcher& operator=(Prefetcher&&) = delete;
+
+        /**
+         * Waits for the files being parsed, the files not parsed yet are dropped.
+        */
+        ~Prefetcher();
+
+        /**
+         * Starts parsing the files imported by a tree with a string literal.
+         * @param expression the tree.
+        */
+        void prefetch(std::shared_ptr<Expression> const& expression);
+
+        /**
+         * Gets the tree of a prefetched file, waiting for it if it is being parsed.
+         * The exception thrown by the parser is rethrown.
+         * @param path the canonical path of the file.
+         * @param code the content of the file now that it is imported, the tree is not used if the file was modified since it was parsed.
+         * @return the tree with its symbols computed, or null if the file was not prefetched.
+        */
+        [[nodiscard]] std::shared_ptr<Expression> get(std::filesystem::path const& path, std::string const& code);
+
+        /**
+         * Gets the tree of a source file with its symbols computed, from the cache or by parsing it.
+         * @param path the canonical path of the file.
+         * @param code the content of the file.
+         * @param available_symbols the symbols available when the symbols of the tree are computed.
+         * @return the tree.
+        */
+        [[nodiscard]] static std::shared_ptr<Expression> parse(std::filesystem::path const& path, std::string const& code, std::set<std::string> const& available_symbols);
+
+    };
+
+}
+
+
+#endif
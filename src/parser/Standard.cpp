@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <cctype>
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <ostream>
@@ -8,12 +9,18 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <ouverium/types.h>
+
 #include "Expressions.hpp"
 #include "Standard.hpp"
 
+#include "../Types.hpp"
+
 
 namespace Parser {
 
@@ -77,62 +84,54 @@ namespace Parser {
     }
 
 
-    std::vector<Standard::Word> Standard::get_words() const {
-        std::vector<Word> words;
-
-        size_t b = 0;
-        auto last = '\n';
-        bool is_comment = false;
-        bool is_str = false;
-        bool escape = false;
-
-        size_t line = 1;
-        size_t column = 1;
-        std::string position = "file " + path + ":" + std::to_string(line) + ":" + std::to_string(column);
+    Standard::Lexer::Lexer(std::string const& path) :
+        file(Position::get_file(path)), position(file, line, column) {}
 
-        size_t i{};
-        for (i = 0; i < code.size(); ++i) {
-            char c = code[i];
+    void Standard::Lexer::read(std::string_view code) {
+        auto const add_word = [this]() {
+            if (!word.empty()) {
+                words.emplace_back(std::move(word), position);
+                word.clear();
+            }
+        };
 
+        for (char c : code) {
             if (!is_comment) {
                 if (!is_str) {
                     if (c == '#') {
-                        if (b < i) words.emplace_back(code.substr(b, i - b), position);
-                        b = i + 1;
+                        add_word();
                         is_comment = true;
                     } else if (std::isspace(c)) {
-                        if (b < i) words.emplace_back(code.substr(b, i - b), position);
-                        b = i + 1;
+                        add_word();
                     } else if (c == ',' || c == '\\' || c == '(' || c == ')' || c == '[' || c == ']' || c == '{' || c == '}') {
-                        if (b < i) words.emplace_back(code.substr(b, i - b), position);
+                        add_word();
                         words.emplace_back(std::string(1, c), position);
-                        b = i + 1;
+                        if (c == '(' || c == '[' || c == '{') ++depth;
+                        else if (c == ')' || c == ']' || c == '}') --depth;
                     } else if (c == '\"') {
-                        if (b < i) words.emplace_back(code.substr(b, i - b), position);
-                        b = i;
+                        add_word();
+                        word += c;
                         is_str = true;
-                    } else if (is_operator(last) && !is_operator(c) && b < i) {
-                        words.emplace_back(code.substr(b, i - b), position);
-                        b = i;
-                    } else if (is_number(last) && !is_number(c) && b < i) {
-                        words.emplace_back(code.substr(b, i - b), position);
-                        b = i;
-                    } else if (is_alphanum(last) && !is_alphanum(c) && b < i && (!is_number(code.substr(b, i - b)) || c != '.')) {
-                        words.emplace_back(code.substr(b, i - b), position);
-                        b = i;
+                    } else {
+                        if (!word.empty() && (
+                            (is_operator(last) && !is_operator(c)) ||
+                            (is_number(last) && !is_number(c)) ||
+                            (is_alphanum(last) && !is_alphanum(c) && (!is_number(word) || c != '.'))
+                        ))
+                            add_word();
+                        word += c;
                     }
                 } else {
+                    word += c;
                     if (!escape) {
                         if (c == '\"') {
-                            words.emplace_back(code.substr(b, i - b + 1), position);
-                            b = i + 1;
+                            add_word();
                             is_str = false;
                         } else if (c == '\\') escape = true;
                     } else escape = false;
                 }
             } else {
                 if (c == '\n') is_comment = false;
-                b = i + 1;
             }
 
             last = c;
@@ -140,13 +139,49 @@ namespace Parser {
                 ++line;
                 column = 1;
             } else ++column;
-            position = "file " + path + ":" + std::to_string(line) + ":" + std::to_string(column);
+            position = Position(file, line, column);
+        }
+    }
+
+    void Standard::Lexer::flush() {
+        if (!word.empty()) {
+            words.emplace_back(std::move(word), position);
+            word.clear();
         }
-        if (b < i && !is_comment) words.emplace_back(code.substr(b, i - b), position);
+    }
 
+    bool Standard::Lexer::is_complete() const {
+        return !is_str && word.empty() && depth <= 0 && !words.empty() && !is_system(words.back());
+    }
+
+    std::vector<Standard::Word> const& Standard::Lexer::get_words() const {
         return words;
     }
 
+    std::vector<Standard::Word> Standard::Lexer::take_words() {
+        auto taken = std::move(words);
+        words.clear();
+        depth = 0;
+        return taken;
+    }
+
+    void Standard::Lexer::clear() {
+        words.clear();
+        depth = 0;
+    }
+
+    std::vector<Standard::Word> Standard::get_words() const {
+        Lexer lexer(path);
+        lexer.read(code);
+        lexer.flush();
+        return lexer.take_words();
+    }
+
+    /**
+     * The expressions written between brackets, whose operators are not applied to the surrounding expressions.
+    */
+    using Escaped = std::unordered_set<std::shared_ptr<Expression>>;
+
     int get_char_priority(char const& c) {
         if (c == '^') return 1;
         if (c == '*' || c == '/' || c == '%') return 2;
@@ -169,7 +204,48 @@ namespace Parser {
     }
 
 
-    std::shared_ptr<Expression> expressions_to_expression(std::vector<Standard::ParsingError>& errors, std::vector<std::shared_ptr<Expression>> expressions, std::shared_ptr<Expression> expression, bool is_function, std::vector<std::shared_ptr<Expression>> const& escaped) {
+    /**
+     * Groups a sequence of expressions separated by binary operators, the operators are at the odd indexes.
+     * The operators with the highest priority are grouped first, and the operators with the same priority from left to right.
+     * @param expressions the sequence, of odd size.
+     * @return the grouped expression.
+    */
+    std::shared_ptr<Expression> group_operators(std::vector<std::shared_ptr<Expression>> const& expressions) {
+        std::vector<std::shared_ptr<Expression>> operands;
+        std::vector<std::shared_ptr<Symbol>> operators;
+
+        auto reduce = [&operands, &operators]() {
+            auto symbol = operators.back();
+            operators.pop_back();
+
+            auto function_call = std::make_shared<FunctionCall>();
+            function_call->position = symbol->position;
+            function_call->function = symbol;
+            auto tuple = std::make_shared<Tuple>();
+            tuple->position = function_call->position;
+            tuple->objects.push_back(operands[operands.size() - 2]);
+            tuple->objects.push_back(operands.back());
+            function_call->arguments = tuple;
+
+            operands.pop_back();
+            operands.back() = function_call;
+        };
+
+        operands.push_back(expressions[0]);
+        for (size_t i = 1; i + 1 < expressions.size(); i += 2) {
+            auto symbol = std::static_pointer_cast<Symbol>(expressions[i]);
+            while (!operators.empty() && compare_operators(operators.back()->name, symbol->name) >= 0)
+                reduce();
+            operators.push_back(symbol);
+            operands.push_back(expressions[i + 1]);
+        }
+        while (!operators.empty())
+            reduce();
+
+        return operands[0];
+    }
+
+    std::shared_ptr<Expression> expressions_to_expression(std::vector<std::shared_ptr<Expression>> expressions, std::shared_ptr<Expression> expression, bool is_function) {
         if (expressions.empty()) {
             return expression;
         } else {
@@ -191,66 +267,18 @@ namespace Parser {
 
                 return function_call;
             } else {
-                std::vector<std::vector<std::string>> operators;
-                for (auto const& expr : expressions) {
-                    if (auto symbol = std::dynamic_pointer_cast<Symbol>(expr)) {
-                        if (is_operator(symbol->name) && std::ranges::find(escaped, symbol) == escaped.end()) {
-                            bool put = false;
-                            for (auto& op : operators) {
-                                if (compare_operators(symbol->name, op[0]) == 0) {
-                                    op.push_back(symbol->name);
-                                    put = true;
-                                    break;
-                                }
-                            }
-                            if (!put) {
-                                std::vector<std::string> op;
-                                op.push_back(symbol->name);
-                                operators.push_back(op);
-                            }
-                        }
-                    }
-                }
-
-                std::ranges::sort(operators, [](auto const& a, auto const& b) {
-                    return compare_operators(a[0], b[0]) >= 0;
-                });
-
-                for (auto const& op : operators) {
-                    for (auto it = expressions.begin(); it != expressions.end();) {
-                        if (auto symbol = std::dynamic_pointer_cast<Symbol>(*it)) {
-                            if (std::ranges::find(op, symbol->name) != op.end() && std::ranges::find(escaped, symbol) == escaped.end()) {
-                                if (expressions.begin() <= it - 1 && it + 1 < expressions.end()) {
-                                    auto function_call = std::make_shared<FunctionCall>();
-                                    function_call->position = symbol->position;
-                                    function_call->function = *it;
-                                    auto tuple = std::make_shared<Tuple>();
-                                    tuple->position = function_call->position;
-                                    tuple->objects.push_back(*(it - 1));
-                                    tuple->objects.push_back(*(it + 1));
-                                    function_call->arguments = tuple;
-
-                                    *(it - 1) = function_call;
-                                    it = expressions.erase(it);
-                                    it = expressions.erase(it);
-                                } else errors.emplace_back("operator " + symbol->name + " must be placed between two expressions", symbol->position);
-                            } else ++it;
-                        } else ++it;
-                    }
-                }
-
-                return expressions[0];
+                return group_operators(expressions);
             }
         }
     }
 
-    std::shared_ptr<Expression> get_expression(std::vector<Standard::ParsingError>& errors, std::vector<Standard::Word> const& words, size_t& i, std::vector<std::shared_ptr<Expression>>& escaped, bool in_tuple, bool in_function, bool in_operator, bool priority) {
+    std::shared_ptr<Expression> get_expression(std::vector<Standard::ParsingError>& errors, std::vector<Standard::Word> const& words, size_t& i, Escaped& escaped, bool in_tuple, bool in_function, bool in_operator, bool priority) {
         std::shared_ptr<Expression> expression = nullptr;
 
         if (words.at(i) == "(") {
             ++i;
             expression = get_expression(errors, words, i, escaped, false, false, false, true);
-            escaped.push_back(expression);
+            escaped.insert(expression);
             if (words.at(i) == ")") ++i;
             else errors.emplace_back(") expected", words.at(i).position);
         } else if (words.at(i) == ")") {
@@ -259,12 +287,12 @@ namespace Parser {
                 errors.emplace_back(") unexpected", words.at(i).position);
                 return expression;
             }
-            escaped.push_back(expression);
+            escaped.insert(expression);
             expression->position = words[i - 1].position;
         } else if (words.at(i) == "[") {
             ++i;
             expression = get_expression(errors, words, i, escaped, false, false, false, true);
-            escaped.push_back(expression);
+            escaped.insert(expression);
             if (words.at(i) == "]") ++i;
             else errors.emplace_back("] expected", words.at(i).position);
         } else if (words.at(i) == "]") {
@@ -273,12 +301,12 @@ namespace Parser {
                 errors.emplace_back("] unexpected", words.at(i).position);
                 return expression;
             }
-            escaped.push_back(expression);
+            escaped.insert(expression);
             expression->position = words[i - 1].position;
         } else if (words.at(i) == "{") {
             ++i;
             expression = get_expression(errors, words, i, escaped, false, false, false, true);
-            escaped.push_back(expression);
+            escaped.insert(expression);
             if (words.at(i) == "}") ++i;
             else errors.emplace_back("} expected", words.at(i).position);
         } else if (words.at(i) == "}") {
@@ -287,12 +315,22 @@ namespace Parser {
                 errors.emplace_back("} unexpected", words.at(i).position);
                 return expression;
             }
-            escaped.push_back(expression);
+            escaped.insert(expression);
             expression->position = words[i - 1].position;
         } else {
-            auto symbol = std::make_shared<Symbol>();
+            std::shared_ptr<Symbol> symbol;
+            auto data = get_symbol(words.at(i));
+            if (auto* b = std::get_if<bool>(&data))
+                symbol = std::make_shared<Literal>(words.at(i), *b);
+            else if (auto* l = std::get_if<OV_INT>(&data))
+                symbol = std::make_shared<Literal>(words.at(i), *l);
+            else if (auto* d = std::get_if<OV_FLOAT>(&data))
+                symbol = std::make_shared<Literal>(words.at(i), *d);
+            else if (auto* str = std::get_if<std::string>(&data))
+                symbol = std::make_shared<Literal>(words.at(i), std::move(*str));
+            else
+                symbol = std::make_shared<Symbol>(words.at(i));
             symbol->position = words.at(i).position;
-            symbol->name = words.at(i);
             expression = symbol;
             if (is_system(words.at(i)))
                 errors.emplace_back(words.at(i) + " is reserved", words.at(i).position);
@@ -309,7 +347,7 @@ namespace Parser {
 
             if (words.at(i) == ".") {
                 if (is_function) {
-                    expression = expressions_to_expression(errors, expressions, expression, is_function, escaped);
+                    expression = expressions_to_expression(expressions, expression, is_function);
                     expressions.clear();
                 }
 
@@ -330,7 +368,7 @@ namespace Parser {
                 if (!in_tuple && priority) {
                     auto tuple = std::make_shared<Tuple>();
                     tuple->position = words.at(i).position;
-                    tuple->objects.push_back(expressions_to_expression(errors, expressions, expression, is_function, escaped));
+                    tuple->objects.push_back(expressions_to_expression(expressions, expression, is_function));
                     while (words.at(i) == ",") {
                         ++i;
                         auto const& w = words.at(i);
@@ -374,7 +412,7 @@ namespace Parser {
                 } else break;
             }
             if (auto symbol = std::dynamic_pointer_cast<Symbol>(expression)) {
-                if (is_operator(symbol->name) && std::ranges::find(escaped, symbol) == escaped.end()) {
+                if (is_operator(symbol->name) && !escaped.contains(symbol)) {
                     auto function_call = std::make_shared<FunctionCall>();
                     function_call->position = symbol->position;
 
@@ -390,7 +428,7 @@ namespace Parser {
                     if (in_operator) break;
                     else {
                         if (is_function) {
-                            expression = expressions_to_expression(errors, expressions, expression, is_function, escaped);
+                            expression = expressions_to_expression(expressions, expression, is_function);
                             expressions.clear();
                             is_function = false;
                         }
@@ -417,16 +455,19 @@ namespace Parser {
 
         }
 
-        return expressions_to_expression(errors, expressions, expression, is_function, escaped);
+        return expressions_to_expression(expressions, expression, is_function);
     }
 
     std::shared_ptr<Expression> Standard::get_tree() const {
+        return get_tree(get_words());
+    }
+
+    std::shared_ptr<Expression> Standard::get_tree(std::vector<Word> const& words) {
         std::vector<Standard::ParsingError> errors;
 
         try {
-            auto words = get_words();
             size_t i = 0;
-            std::vector<std::shared_ptr<Expression>> escaped;
+            Escaped escaped;
             auto expression = get_expression(errors, words, i, escaped, false, false, false, true);
 
             if (errors.empty())
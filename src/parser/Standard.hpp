@@ -3,9 +3,11 @@
 
 #include "Expressions.hpp"
 
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -19,16 +21,71 @@ namespace Parser {
         Standard(std::string code, std::string path);
 
         struct Word : public std::string {
-            std::string position;
+            Parser::Position position;
 
             Word(std::string word, Parser::Position position);
         };
 
         [[nodiscard]] std::vector<Word> get_words() const;
 
+        /**
+         * A lexer which can read the code piece by piece, keeping the positions across the pieces.
+        */
+        class Lexer {
+
+            std::vector<Word> words;
+            std::string word;
+
+            char last = '\n';
+            bool is_comment = false;
+            bool is_str = false;
+            bool escape = false;
+            int depth = 0;
+
+            uint32_t file;
+            uint32_t line = 1;
+            uint32_t column = 1;
+            Parser::Position position;
+
+        public:
+
+            explicit Lexer(std::string const& path);
+
+            /**
+             * Reads a piece of code, the words it completes are added to the words.
+             * @param code the piece of code.
+            */
+            void read(std::string_view code);
+
+            /**
+             * Adds the word being read, at the end of the code.
+            */
+            void flush();
+
+            /**
+             * Checks if the words read can form a complete expression, that is if no bracket or string is left open and if the last word does not expect a following one.
+             * @return true if the words can be parsed.
+            */
+            [[nodiscard]] bool is_complete() const;
+
+            [[nodiscard]] std::vector<Word> const& get_words() const;
+
+            /**
+             * Moves out the words read.
+             * @return the words.
+            */
+            [[nodiscard]] std::vector<Word> take_words();
+
+            /**
+             * Removes the words read, the positions keep going on.
+            */
+            void clear();
+
+        };
+
         struct ParsingError {
             std::string message;
-            std::string position;
+            Parser::Position position;
 
             ParsingError(std::string message, Parser::Position position) :
                 message(std::move(message)), position(std::move(position)) {}
@@ -50,6 +107,13 @@ namespace Parser {
 
         [[nodiscard]] std::shared_ptr<Expression> get_tree() const;
 
+        /**
+         * Builds the tree of a sequence of words.
+         * @param words the words.
+         * @return the tree.
+        */
+        [[nodiscard]] static std::shared_ptr<Expression> get_tree(std::vector<Word> const& words);
+
     protected:
 
         std::string code;
@@ -0,0 +1,24 @@
+# Runs scripts with the tree walker and with the virtual machine, and fails if their outputs differ.
+# Usage: cmake -DOUVERIUM=<executable> -DSCRIPTS=<script|script> -P engines.cmake
+
+string(REPLACE "|" ";" SCRIPTS "${SCRIPTS}")
+foreach(script ${SCRIPTS})
+    execute_process(
+        COMMAND ${OUVERIUM} --tree-walker ${script}
+        OUTPUT_VARIABLE tree_walker_output ERROR_VARIABLE tree_walker_error RESULT_VARIABLE tree_walker_result
+    )
+    execute_process(
+        COMMAND ${OUVERIUM} --vm ${script}
+        OUTPUT_VARIABLE vm_output ERROR_VARIABLE vm_error RESULT_VARIABLE vm_result
+    )
+
+    if(NOT tree_walker_result EQUAL 0)
+        message(FATAL_ERROR "${script} failed with the tree walker:\n${tree_walker_error}")
+    endif()
+    if(NOT vm_result EQUAL 0)
+        message(FATAL_ERROR "${script} failed with the virtual machine:\n${vm_error}")
+    endif()
+    if(NOT tree_walker_output STREQUAL vm_output)
+        message(FATAL_ERROR "${script} prints different outputs:\ntree walker:\n${tree_walker_output}\nvirtual machine:\n${vm_output}")
+    endif()
+endforeach()